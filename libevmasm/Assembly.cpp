@@ -25,6 +25,7 @@
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/PeepholeOptimiser.h>
 #include <libevmasm/JumpdestRemover.h>
+#include <libevmasm/JumpThreader.h>
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/GasMeter.h>
@@ -374,6 +375,7 @@ Assembly& Assembly::optimise(bool _enable, EVMVersion _evmVersion, bool _isCreat
 	if (_enable)
 	{
 		settings.runDeduplicate = true;
+		settings.runJumpThreader = true;
 		settings.runCSE = true;
 		settings.runConstantOptimiser = true;
 	}
@@ -432,6 +434,13 @@ map<u256, u256> Assembly::optimiseInternal(
 			}
 		}
 
+		if (_settings.runJumpThreader)
+		{
+			JumpThreader jumpThreader{m_items};
+			if (jumpThreader.optimise(_tagsReferencedFromOutside))
+				count++;
+		}
+
 		// This only modifies PushTags, we have to run again to actually remove code.
 		if (_settings.runDeduplicate)
 		{
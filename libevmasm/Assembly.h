@@ -106,6 +106,7 @@ public:
 		bool runJumpdestRemover = false;
 		bool runPeephole = false;
 		bool runDeduplicate = false;
+		bool runJumpThreader = false;
 		bool runCSE = false;
 		bool runConstantOptimiser = false;
 		langutil::EVMVersion evmVersion;
@@ -105,6 +105,8 @@ namespace GasCosts
 		return _evmVersion >= langutil::EVMVersion::istanbul() ? 16 : 68;
 	}
 	static unsigned const copyGas = 3;
+	static unsigned const identityGas = 15;
+	static unsigned const identityWordGas = 3;
 }
 
 /**
@@ -0,0 +1,199 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Threads jumps through blocks that only consist of a jump and moves blocks
+ * that are only reached by a single jump to the location of that jump.
+ */
+
+#include <libevmasm/JumpThreader.h>
+
+#include <libevmasm/AssemblyItem.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <algorithm>
+#include <map>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::evmasm;
+
+namespace
+{
+
+bool isLocalPushTag(AssemblyItem const& _item)
+{
+	return _item.type() == PushTag && _item.splitForeignPushTag().first == size_t(-1);
+}
+
+size_t tagOf(AssemblyItem const& _item)
+{
+	return _item.splitForeignPushTag().second;
+}
+
+bool isOrdinaryJump(AssemblyItem const& _item)
+{
+	return _item == Instruction::JUMP && _item.getJumpType() == AssemblyItem::JumpType::Ordinary;
+}
+
+/// @returns true if control flow never continues after @a _item.
+bool terminatesBlock(AssemblyItem const& _item)
+{
+	return _item == Instruction::JUMP || SemanticInformation::terminatesControlFlow(_item);
+}
+
+}
+
+bool JumpThreader::optimise(set<size_t> const& _tagsReferencedFromOutside)
+{
+	bool changed = threadJumps();
+	if (invertConditionalJumps())
+		changed = true;
+	if (moveBlocks(_tagsReferencedFromOutside))
+		changed = true;
+	return changed;
+}
+
+bool JumpThreader::threadJumps()
+{
+	// Tags of blocks that only consist of an unconditional jump, mapped to the target of the jump.
+	map<size_t, size_t> trampolines;
+	for (size_t i = 0; i < m_items.size(); ++i)
+	{
+		if (m_items[i].type() != Tag)
+			continue;
+		size_t j = i;
+		while (j < m_items.size() && m_items[j].type() == Tag)
+			++j;
+		if (j + 1 < m_items.size() && isLocalPushTag(m_items[j]) && isOrdinaryJump(m_items[j + 1]))
+			for (size_t k = i; k < j; ++k)
+				trampolines[tagOf(m_items[k])] = tagOf(m_items[j]);
+		i = j - 1;
+	}
+
+	bool changed = false;
+	for (size_t i = 0; i + 1 < m_items.size(); ++i)
+		if (
+			isLocalPushTag(m_items[i]) &&
+			(isOrdinaryJump(m_items[i + 1]) || m_items[i + 1] == Instruction::JUMPI)
+		)
+		{
+			size_t originalTarget = tagOf(m_items[i]);
+			size_t target = originalTarget;
+			// Stop at cycles of trampolines, jumping to any of their tags is equivalent.
+			set<size_t> visited;
+			while (trampolines.count(target) && visited.insert(target).second)
+				target = trampolines.at(target);
+			if (target != originalTarget)
+			{
+				m_items[i].setPushTagSubIdAndTag(size_t(-1), target);
+				changed = true;
+			}
+		}
+	return changed;
+}
+
+bool JumpThreader::invertConditionalJumps()
+{
+	AssemblyItems items;
+	for (size_t i = 0; i < m_items.size(); ++i)
+	{
+		if (
+			i + 4 < m_items.size() &&
+			isLocalPushTag(m_items[i]) &&
+			m_items[i + 1] == Instruction::JUMPI &&
+			isLocalPushTag(m_items[i + 2]) &&
+			isOrdinaryJump(m_items[i + 3]) &&
+			m_items[i + 4].type() == Tag &&
+			tagOf(m_items[i]) == tagOf(m_items[i + 4])
+		)
+		{
+			items.emplace_back(Instruction::ISZERO, m_items[i + 1].location());
+			items.emplace_back(move(m_items[i + 2]));
+			items.emplace_back(move(m_items[i + 1]));
+			i += 3;
+		}
+		else
+			items.emplace_back(move(m_items[i]));
+	}
+	bool changed = items.size() != m_items.size();
+	m_items = move(items);
+	return changed;
+}
+
+bool JumpThreader::moveBlocks(set<size_t> const& _tagsReferencedFromOutside)
+{
+	map<size_t, size_t> references;
+	map<size_t, size_t> tagPositions;
+	for (size_t i = 0; i < m_items.size(); ++i)
+		if (isLocalPushTag(m_items[i]))
+			references[tagOf(m_items[i])]++;
+		else if (m_items[i].type() == Tag)
+			tagPositions[tagOf(m_items[i])] = i;
+
+	// Maps the position of a jump to the range of items moved there, and vice versa.
+	map<size_t, pair<size_t, size_t>> movesByJump;
+	map<size_t, size_t> movedRanges;
+	vector<bool> affected(m_items.size(), false);
+	for (size_t i = 0; i + 1 < m_items.size(); ++i)
+	{
+		if (!isLocalPushTag(m_items[i]) || !isOrdinaryJump(m_items[i + 1]))
+			continue;
+		size_t tag = tagOf(m_items[i]);
+		if (references[tag] != 1 || _tagsReferencedFromOutside.count(tag) || !tagPositions.count(tag))
+			continue;
+
+		size_t begin = tagPositions.at(tag);
+		if (begin == 0 || !terminatesBlock(m_items[begin - 1]))
+			continue;
+		size_t end = begin;
+		while (end < m_items.size() && !terminatesBlock(m_items[end]))
+			++end;
+		if (end == m_items.size())
+			continue;
+		++end;
+
+		if (i + 1 >= begin && i < end)
+			continue;
+		if (affected[i] || affected[i + 1] || find(affected.begin() + begin, affected.begin() + end, true) != affected.begin() + end)
+			continue;
+		fill(affected.begin() + begin, affected.begin() + end, true);
+		affected[i] = affected[i + 1] = true;
+		movesByJump[i] = {begin, end};
+		movedRanges[begin] = end;
+	}
+	if (movesByJump.empty())
+		return false;
+
+	AssemblyItems items;
+	items.reserve(m_items.size());
+	for (size_t i = 0; i < m_items.size();)
+		if (movesByJump.count(i))
+		{
+			auto [begin, end] = movesByJump.at(i);
+			for (size_t j = begin; j < end; ++j)
+				items.emplace_back(move(m_items[j]));
+			// Skip the push of the tag and the jump.
+			i += 2;
+		}
+		else if (movedRanges.count(i))
+			i = movedRanges.at(i);
+		else
+			items.emplace_back(move(m_items[i++]));
+	m_items = move(items);
+	return true;
+}
@@ -0,0 +1,65 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Threads jumps through blocks that only consist of a jump and moves blocks
+ * that are only reached by a single jump to the location of that jump.
+ */
+#pragma once
+
+#include <cstddef>
+#include <set>
+#include <vector>
+
+namespace solidity::evmasm
+{
+class AssemblyItem;
+using AssemblyItems = std::vector<AssemblyItem>;
+
+/**
+ * Optimizer class that improves the layout of the jumps and blocks in an assembly.
+ * Modifies the passed vector in place.
+ *
+ * Since tags can be jumped to from anywhere once they are pushed (e.g. as internal function
+ * pointers), the transformations only change the targets of pushed tags that are
+ * directly used by a jump and only remove references to tags, they do not make
+ * assumptions about the set of predecessors of a tag:
+ *  - a jump to a block that only consists of an unconditional jump is replaced by a jump
+ *    to the target of that jump,
+ *  - ``PUSH A JUMPI PUSH B JUMP A:`` is replaced by ``ISZERO PUSH B JUMPI A:``,
+ *  - a block that is not reached by falling through from the preceding code and whose tag
+ *    is only referenced by a single unconditional jump is moved to the location of that
+ *    jump, together with the blocks it falls through to, and the jump is removed.
+ * Jumps into and out of functions are left unchanged, so that the jump annotations stay
+ * consistent. Tags that become unused are removed by the JumpdestRemover.
+ */
+class JumpThreader
+{
+public:
+	explicit JumpThreader(AssemblyItems& _items): m_items(_items) {}
+
+	/// @returns true if something was changed.
+	bool optimise(std::set<size_t> const& _tagsReferencedFromOutside);
+
+private:
+	bool threadJumps();
+	bool invertConditionalJumps();
+	bool moveBlocks(std::set<size_t> const& _tagsReferencedFromOutside);
+
+	AssemblyItems& m_items;
+};
+
+}
@@ -85,18 +85,14 @@ string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
 	using size_type = string::size_type;
+	vector<size_t> const& starts = lineStarts();
 	size_type searchStart = min<size_type>(m_source.size(), _position);
 	if (searchStart > 0)
 		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
-	string line = m_source.substr(
-		lineStart,
-		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
-	);
+	// The line containing searchStart, or the line after it if searchStart is a line break.
+	auto lineStart = upper_bound(starts.begin(), starts.end(), searchStart + 1) - 1;
+	size_type lineEnd = next(lineStart) == starts.end() ? m_source.size() : *next(lineStart) - 1;
+	string line{m_source.substr(*lineStart, lineEnd - *lineStart)};
 	if (!line.empty() && line.back() == '\r')
 		line.pop_back();
 	return line;
@@ -105,15 +101,20 @@ string CharStream::lineAtPosition(int _position) const
 tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
 	using size_type = string::size_type;
+	vector<size_t> const& starts = lineStarts();
 	size_type searchPosition = min<size_type>(m_source.size(), _position);
-	int lineNumber = count(m_source.begin(), m_source.begin() + searchPosition, '\n');
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
+	auto lineStart = upper_bound(starts.begin(), starts.end(), searchPosition) - 1;
+	return tuple<int, int>(lineStart - starts.begin(), searchPosition - *lineStart);
+}
+
+vector<size_t> const& CharStream::lineStarts() const
+{
+	if (!m_lineStarts)
 	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
+		vector<size_t> starts{0};
+		for (size_t position = m_source.find('\n'); position != string_view::npos; position = m_source.find('\n', position + 1))
+			starts.push_back(position + 1);
+		m_lineStarts = make_shared<vector<size_t> const>(std::move(starts));
 	}
-	return tuple<int, int>(lineNumber, searchPosition - lineStart);
+	return *m_lineStarts;
 }
@@ -52,9 +52,14 @@
 
 #pragma once
 
+#include <libsolutil/MappedFile.h>
+
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <vector>
 
 namespace solidity::langutil
 {
@@ -63,18 +68,35 @@ namespace solidity::langutil
  * Bidirectional stream of characters.
  *
  * This CharStream is used by lexical analyzers as the source.
+ * The characters are immutable and shared between copies of the stream. They are
+ * either owned by the stream or belong to a file that is mapped into memory.
  */
 class CharStream
 {
 public:
 	CharStream() = default;
-	explicit CharStream(std::string const& _source, std::string const& name):
-		m_source(_source), m_name(name) {}
+	explicit CharStream(std::string _source, std::string name):
+		m_storage(std::make_shared<std::string const>(std::move(_source))),
+		m_source(*std::static_pointer_cast<std::string const>(m_storage)),
+		m_name(std::move(name))
+	{}
+	/// Creates a stream over the contents of @a _file without copying them.
+	/// The file is kept alive as long as the stream or any of its copies exist.
+	explicit CharStream(std::shared_ptr<util::MappedFile const> _file, std::string name):
+		m_storage(_file),
+		m_source(_file->contents()),
+		m_name(std::move(name))
+	{}
 
 	int position() const { return m_position; }
 	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source.size(); }
 
-	char get(size_t _charsForward = 0) const { return m_source[m_position + _charsForward]; }
+	/// @returns the character @a _charsForward characters after the current position or
+	/// zero if that is past the end of the input.
+	char get(size_t _charsForward = 0) const
+	{
+		return isPastEndOfInput(_charsForward) ? '\0' : m_source[m_position + _charsForward];
+	}
 	char advanceAndGet(size_t _chars = 1);
 	/// Sets scanner position to @ _amount characters backwards in source text.
 	/// @returns The character of the current location after update is returned.
@@ -86,21 +108,28 @@ public:
 
 	void reset() { m_position = 0; }
 
-	std::string const& source() const noexcept { return m_source; }
+	std::string_view source() const noexcept { return m_source; }
 	std::string const& name() const noexcept { return m_name; }
 
 	///@{
 	///@name Error printing helper functions
 	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// The first call builds an index of the lines, further calls only search it.
 	std::string lineAtPosition(int _position) const;
 	std::tuple<int, int> translatePositionToLineColumn(int _position) const;
 	///@}
 
 private:
-	std::string m_source;
+	/// Owner of the characters @a m_source refers to.
+	std::shared_ptr<void const> m_storage;
+	/// Never has a null data pointer, so that empty streams can be scanned, too.
+	std::string_view m_source = "";
 	std::string m_name;
 	size_t m_position{0};
+	/// Offsets at which the lines of the source start, built on first use.
+	mutable std::shared_ptr<std::vector<size_t> const> m_lineStarts;
+
+	std::vector<size_t> const& lineStarts() const;
 };
 
 }
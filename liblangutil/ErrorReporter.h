@@ -50,6 +50,10 @@ public:
 		m_errorList += _errorList;
 	}
 
+	/// Appends the errors of @a _errorList as if they had been reported through this reporter,
+	/// i.e. subject to the same limits on the number of warnings and errors.
+	void appendWithLimits(ErrorList const& _errorList);
+
 	void warning(std::string const& _description);
 
 	void warning(SourceLocation const& _location, std::string const& _description);
@@ -85,7 +85,7 @@ struct SourceLocation
 		assertThrow(0 <= start, SourceLocationError, "Invalid source location.");
 		assertThrow(start <= end, SourceLocationError, "Invalid source location.");
 		assertThrow(end <= int(source->source().length()), SourceLocationError, "Invalid source location.");
-		return source->source().substr(start, end - start);
+		return std::string(source->source().substr(start, end - start));
 	}
 
 	/// @returns the smallest SourceLocation that contains both @param _a and @param _b.
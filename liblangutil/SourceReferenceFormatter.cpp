@@ -24,6 +24,11 @@
 #include <liblangutil/Scanner.h>
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/Common.h>
+
+#include <map>
+#include <set>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -86,6 +91,55 @@ void SourceReferenceFormatter::printErrorInformation(Error const& _error)
 	);
 }
 
+void SourceReferenceFormatter::printErrorInformation(
+	ErrorList const& _errors,
+	bool _deduplicate,
+	optional<size_t> _maxRepeatedWarnings
+)
+{
+	// Renders an error using the formatter without writing to the actual stream.
+	auto render = [&](Error const& _error)
+	{
+		ostringstream rendered;
+		streambuf* originalBuffer = m_stream.rdbuf(rendered.rdbuf());
+		ScopeGuard restoreBuffer([&]() { m_stream.rdbuf(originalBuffer); });
+		printErrorInformation(_error);
+		return rendered.str();
+	};
+
+	string output;
+	set<string> printed;
+	map<string, size_t> warningCounts;
+	vector<string> omittedWarnings;
+	for (auto const& error: _errors)
+	{
+		string rendered = render(*error);
+		if (_deduplicate && !printed.insert(rendered).second)
+			continue;
+		if (_maxRepeatedWarnings && error->type() == Error::Type::Warning)
+			if (string const* message = boost::get_error_info<errinfo_comment>(*error))
+				if (++warningCounts[*message] > *_maxRepeatedWarnings)
+				{
+					if (warningCounts[*message] == *_maxRepeatedWarnings + 1)
+						omittedWarnings.push_back(*message);
+					continue;
+				}
+		output += rendered;
+	}
+	for (string const& message: omittedWarnings)
+	{
+		size_t omitted = warningCounts[message] - *_maxRepeatedWarnings;
+		Error summary(
+			Error::Type::Warning,
+			std::to_string(omitted) +
+			(omitted == 1 ? " further warning with the following message was omitted: " : " further warnings with the following message were omitted: ") +
+			message
+		);
+		output += render(summary);
+	}
+	m_stream << output;
+}
+
 void SourceReferenceFormatter::printExceptionInformation(SourceReferenceExtractor::Message const& _msg)
 {
 	printSourceName(_msg.primary);
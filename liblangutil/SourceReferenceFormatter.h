@@ -25,6 +25,7 @@
 #include <ostream>
 #include <sstream>
 #include <functional>
+#include <optional>
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/SourceReferenceExtractor.h>
 
@@ -55,6 +56,16 @@ public:
 	virtual void printExceptionInformation(util::Exception const& _exception, std::string const& _category);
 	virtual void printErrorInformation(Error const& _error);
 
+	/// Prints all errors of @a _errors in order and writes them to the stream at once.
+	/// If @a _deduplicate is set, errors that look exactly like one printed before are skipped.
+	/// If @a _maxRepeatedWarnings is set, at most that many warnings with the same message are
+	/// printed and the number of omitted ones is reported at the end.
+	void printErrorInformation(
+		ErrorList const& _errors,
+		bool _deduplicate = false,
+		std::optional<size_t> _maxRepeatedWarnings = std::nullopt
+	);
+
 	static std::string formatErrorInformation(Error const& _error)
 	{
 		return formatExceptionInformation(
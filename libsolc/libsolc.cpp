@@ -21,6 +21,7 @@
  */
 
 #include <libsolc/libsolc.h>
+#include <libsolidity/interface/ReadCallbackCache.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
 #include <libyul/YulString.h>
@@ -29,6 +30,7 @@
 
 #include <cstdlib>
 #include <list>
+#include <memory>
 #include <string>
 
 #include "license.h"
@@ -38,6 +40,7 @@ using namespace solidity;
 using namespace solidity::util;
 
 using solidity::frontend::ReadCallback;
+using solidity::frontend::ReadCallbackCache;
 using solidity::frontend::StandardCompiler;
 
 namespace
@@ -47,6 +50,9 @@ namespace
 // this may potentially change the pointer that was passed to the caller from solidity_alloc().
 static list<string> solidityAllocations;
 
+/// Files returned by the read callback, if caching is enabled.
+static unique_ptr<ReadCallbackCache> readCallbackCache;
+
 /// Find the equivalent to @p _data in the list of allocations of solidity_alloc(),
 /// removes it from the list and returns its value.
 ///
@@ -109,7 +115,10 @@ ReadCallback::Callback wrapReadCallback(CStyleReadFileCallback _readCallback, vo
 
 string compile(string _input, CStyleReadFileCallback _readCallback, void* _readContext)
 {
-	StandardCompiler compiler(wrapReadCallback(_readCallback, _readContext));
+	ReadCallback::Callback readCallback = wrapReadCallback(_readCallback, _readContext);
+	if (readCallbackCache)
+		readCallback = readCallbackCache->wrap(move(readCallback));
+	StandardCompiler compiler(readCallback);
 	return compiler.compile(move(_input));
 }
 
@@ -151,6 +160,24 @@ extern void solidity_free(char* _data) noexcept
 	takeOverAllocation(_data);
 }
 
+extern void solidity_set_read_cache(bool _enabled) noexcept
+{
+	if (!_enabled)
+		readCallbackCache.reset();
+	else if (!readCallbackCache)
+		readCallbackCache = make_unique<ReadCallbackCache>(ReadCallbackCache::fileFingerprint);
+}
+
+extern void solidity_invalidate_read_cache(char const* _path) noexcept
+{
+	if (!readCallbackCache)
+		return;
+	if (_path)
+		readCallbackCache->invalidate(_path);
+	else
+		readCallbackCache->clear();
+}
+
 extern void solidity_reset() noexcept
 {
 	// This is called right before each compilation, but not at the end, so additional memory
@@ -89,6 +89,17 @@ void solidity_free(char* _data) SOLC_NOEXCEPT;
 /// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
 char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) SOLC_NOEXCEPT;
 
+/// Enables or disables caching of the files returned by the read callback across calls to
+/// solidity_compile(). Only files that exist at the requested path in the local filesystem are
+/// cached. They are read again once their size or modification time changes. Changes that do
+/// not affect either, e.g. within the timestamp resolution of the filesystem, require a call to
+/// solidity_invalidate_read_cache(). Disabling the cache clears it.
+/// The cache is disabled by default and not affected by solidity_reset().
+void solidity_set_read_cache(bool _enabled) SOLC_NOEXCEPT;
+
+/// Removes the file @p _path from the read cache, or all files if @p _path is NULL.
+void solidity_invalidate_read_cache(char const* _path) SOLC_NOEXCEPT;
+
 /// Frees up any allocated memory.
 ///
 /// NOTE: the pointer returned by solidity_compile as well as any other pointer retrieved via solidity_alloc()
@@ -32,14 +32,6 @@ using namespace solidity;
 using namespace solidity::langutil;
 using namespace solidity::frontend;
 
-bool DocStringAnalyser::analyseDocStrings(SourceUnit const& _sourceUnit)
-{
-	m_errorOccured = false;
-	_sourceUnit.accept(*this);
-
-	return !m_errorOccured;
-}
-
 bool DocStringAnalyser::visit(ContractDefinition const& _contract)
 {
 	static set<string> const validTags = set<string>{"author", "title", "dev", "notice"};
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <libsolidity/analysis/FusedAnalysis.h>
 #include <libsolidity/ast/ASTVisitor.h>
 
 namespace solidity::langutil
@@ -37,11 +38,14 @@ namespace solidity::frontend
  * Parses and analyses the doc strings.
  * Stores the parsing results in the AST annotations and reports errors.
  */
-class DocStringAnalyser: private ASTConstVisitor
+class DocStringAnalyser: private ASTConstVisitor, public FusableAnalysis
 {
 public:
 	DocStringAnalyser(langutil::ErrorReporter& _errorReporter): m_errorReporter(_errorReporter) {}
-	bool analyseDocStrings(SourceUnit const& _sourceUnit);
+
+	void beginSourceUnit(SourceUnit const&) override { m_errorOccured = false; }
+	bool endSourceUnit(SourceUnit const&) override { return !m_errorOccured; }
+	ASTConstVisitor& visitor() override { return *this; }
 
 private:
 	bool visit(ContractDefinition const& _contract) override;
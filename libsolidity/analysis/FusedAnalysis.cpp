@@ -0,0 +1,70 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Runs several independent analysis steps in a single traversal of the AST.
+ */
+
+#include <libsolidity/analysis/FusedAnalysis.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+
+bool FusedAnalysis::run(vector<SourceUnit const*> const& _sourceUnits, ErrorReporter& _errorReporter)
+{
+	bool success = true;
+	for (SourceUnit const* sourceUnit: _sourceUnits)
+	{
+		for (auto& step: m_steps)
+			if (!step->failed)
+			{
+				try
+				{
+					step->analysis->beginSourceUnit(*sourceUnit);
+				}
+				catch (FatalError const&)
+				{
+					step->failed = true;
+				}
+			}
+
+		sourceUnit->accept(*this);
+
+		for (auto& step: m_steps)
+			if (!step->failed)
+			{
+				try
+				{
+					if (!step->analysis->endSourceUnit(*sourceUnit))
+						success = false;
+				}
+				catch (FatalError const&)
+				{
+					step->failed = true;
+				}
+			}
+	}
+
+	for (auto& step: m_steps)
+	{
+		_errorReporter.appendWithLimits(step->errors);
+		if (step->failed)
+			BOOST_THROW_EXCEPTION(FatalError());
+	}
+	return success;
+}
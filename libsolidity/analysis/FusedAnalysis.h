@@ -0,0 +1,247 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Runs several independent analysis steps in a single traversal of the AST.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Exceptions.h>
+
+#include <memory>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Analysis step that only reads the AST (apart from its own annotations) and does not depend
+ * on the results of other steps of the same traversal, so that it can share a traversal
+ * with other such steps, see @ref FusedAnalysis.
+ */
+class FusableAnalysis
+{
+public:
+	virtual ~FusableAnalysis() = default;
+
+	/// Called before @a _sourceUnit is traversed.
+	virtual void beginSourceUnit(SourceUnit const&) {}
+	/// Called after @a _sourceUnit has been traversed.
+	/// @returns false if errors were found in the source unit.
+	virtual bool endSourceUnit(SourceUnit const& _sourceUnit) = 0;
+	/// @returns the visitor that is invoked for the nodes of the AST.
+	virtual ASTConstVisitor& visitor() = 0;
+};
+
+/**
+ * Visits each source unit once and forwards every node to all steps that have been added.
+ * A step that returns false from visit does not see the children of that node, but still
+ * receives the corresponding endVisit.
+ *
+ * Every step reports to its own error list. After the traversal, the lists are appended
+ * to the target error reporter in the order in which the steps were added, so that the
+ * errors are the same as if the steps ran one after the other. If a step aborts with a
+ * fatal error, the errors of the steps added after it are dropped and the fatal error is
+ * rethrown once all errors up to it have been appended.
+ */
+class FusedAnalysis: private ASTConstVisitor
+{
+public:
+	/// Creates a step of type @a T from its error reporter and @a _args and adds it.
+	/// @returns the new step, which is owned by this object.
+	template <class T, class... Args>
+	T& add(Args&&... _args)
+	{
+		auto& step = *m_steps.emplace_back(std::make_unique<Step>());
+		auto analysis = std::make_unique<T>(step.errorReporter, std::forward<Args>(_args)...);
+		T& result = *analysis;
+		step.analysis = std::move(analysis);
+		return result;
+	}
+
+	/// Runs all steps on @a _sourceUnits and appends their errors to @a _errorReporter.
+	/// @returns false if any step found an error.
+	bool run(std::vector<SourceUnit const*> const& _sourceUnits, langutil::ErrorReporter& _errorReporter);
+
+private:
+	struct Step
+	{
+		langutil::ErrorList errors;
+		langutil::ErrorReporter errorReporter{errors};
+		std::unique_ptr<FusableAnalysis> analysis;
+		/// Node whose visit returned false, the step is resumed at its endVisit.
+		ASTNode const* suspendedAt = nullptr;
+		/// Set if the step aborted with a fatal error.
+		bool failed = false;
+	};
+
+	bool visit(SourceUnit const& _node) override { return forwardVisit(_node); }
+	bool visit(PragmaDirective const& _node) override { return forwardVisit(_node); }
+	bool visit(ImportDirective const& _node) override { return forwardVisit(_node); }
+	bool visit(ContractDefinition const& _node) override { return forwardVisit(_node); }
+	bool visit(InheritanceSpecifier const& _node) override { return forwardVisit(_node); }
+	bool visit(StructDefinition const& _node) override { return forwardVisit(_node); }
+	bool visit(UsingForDirective const& _node) override { return forwardVisit(_node); }
+	bool visit(EnumDefinition const& _node) override { return forwardVisit(_node); }
+	bool visit(EnumValue const& _node) override { return forwardVisit(_node); }
+	bool visit(ParameterList const& _node) override { return forwardVisit(_node); }
+	bool visit(OverrideSpecifier const& _node) override { return forwardVisit(_node); }
+	bool visit(FunctionDefinition const& _node) override { return forwardVisit(_node); }
+	bool visit(VariableDeclaration const& _node) override { return forwardVisit(_node); }
+	bool visit(ModifierDefinition const& _node) override { return forwardVisit(_node); }
+	bool visit(ModifierInvocation const& _node) override { return forwardVisit(_node); }
+	bool visit(EventDefinition const& _node) override { return forwardVisit(_node); }
+	bool visit(ElementaryTypeName const& _node) override { return forwardVisit(_node); }
+	bool visit(UserDefinedTypeName const& _node) override { return forwardVisit(_node); }
+	bool visit(FunctionTypeName const& _node) override { return forwardVisit(_node); }
+	bool visit(Mapping const& _node) override { return forwardVisit(_node); }
+	bool visit(ArrayTypeName const& _node) override { return forwardVisit(_node); }
+	bool visit(Block const& _node) override { return forwardVisit(_node); }
+	bool visit(PlaceholderStatement const& _node) override { return forwardVisit(_node); }
+	bool visit(IfStatement const& _node) override { return forwardVisit(_node); }
+	bool visit(TryCatchClause const& _node) override { return forwardVisit(_node); }
+	bool visit(TryStatement const& _node) override { return forwardVisit(_node); }
+	bool visit(WhileStatement const& _node) override { return forwardVisit(_node); }
+	bool visit(ForStatement const& _node) override { return forwardVisit(_node); }
+	bool visit(Continue const& _node) override { return forwardVisit(_node); }
+	bool visit(InlineAssembly const& _node) override { return forwardVisit(_node); }
+	bool visit(Break const& _node) override { return forwardVisit(_node); }
+	bool visit(Return const& _node) override { return forwardVisit(_node); }
+	bool visit(Throw const& _node) override { return forwardVisit(_node); }
+	bool visit(EmitStatement const& _node) override { return forwardVisit(_node); }
+	bool visit(VariableDeclarationStatement const& _node) override { return forwardVisit(_node); }
+	bool visit(ExpressionStatement const& _node) override { return forwardVisit(_node); }
+	bool visit(Conditional const& _node) override { return forwardVisit(_node); }
+	bool visit(Assignment const& _node) override { return forwardVisit(_node); }
+	bool visit(TupleExpression const& _node) override { return forwardVisit(_node); }
+	bool visit(UnaryOperation const& _node) override { return forwardVisit(_node); }
+	bool visit(BinaryOperation const& _node) override { return forwardVisit(_node); }
+	bool visit(FunctionCall const& _node) override { return forwardVisit(_node); }
+	bool visit(FunctionCallOptions const& _node) override { return forwardVisit(_node); }
+	bool visit(NewExpression const& _node) override { return forwardVisit(_node); }
+	bool visit(MemberAccess const& _node) override { return forwardVisit(_node); }
+	bool visit(IndexAccess const& _node) override { return forwardVisit(_node); }
+	bool visit(IndexRangeAccess const& _node) override { return forwardVisit(_node); }
+	bool visit(Identifier const& _node) override { return forwardVisit(_node); }
+	bool visit(ElementaryTypeNameExpression const& _node) override { return forwardVisit(_node); }
+	bool visit(Literal const& _node) override { return forwardVisit(_node); }
+	bool visit(StructuredDocumentation const& _node) override { return forwardVisit(_node); }
+
+	void endVisit(SourceUnit const& _node) override { forwardEndVisit(_node); }
+	void endVisit(PragmaDirective const& _node) override { forwardEndVisit(_node); }
+	void endVisit(ImportDirective const& _node) override { forwardEndVisit(_node); }
+	void endVisit(ContractDefinition const& _node) override { forwardEndVisit(_node); }
+	void endVisit(InheritanceSpecifier const& _node) override { forwardEndVisit(_node); }
+	void endVisit(StructDefinition const& _node) override { forwardEndVisit(_node); }
+	void endVisit(UsingForDirective const& _node) override { forwardEndVisit(_node); }
+	void endVisit(EnumDefinition const& _node) override { forwardEndVisit(_node); }
+	void endVisit(EnumValue const& _node) override { forwardEndVisit(_node); }
+	void endVisit(ParameterList const& _node) override { forwardEndVisit(_node); }
+	void endVisit(OverrideSpecifier const& _node) override { forwardEndVisit(_node); }
+	void endVisit(FunctionDefinition const& _node) override { forwardEndVisit(_node); }
+	void endVisit(VariableDeclaration const& _node) override { forwardEndVisit(_node); }
+	void endVisit(ModifierDefinition const& _node) override { forwardEndVisit(_node); }
+	void endVisit(ModifierInvocation const& _node) override { forwardEndVisit(_node); }
+	void endVisit(EventDefinition const& _node) override { forwardEndVisit(_node); }
+	void endVisit(ElementaryTypeName const& _node) override { forwardEndVisit(_node); }
+	void endVisit(UserDefinedTypeName const& _node) override { forwardEndVisit(_node); }
+	void endVisit(FunctionTypeName const& _node) override { forwardEndVisit(_node); }
+	void endVisit(Mapping const& _node) override { forwardEndVisit(_node); }
+	void endVisit(ArrayTypeName const& _node) override { forwardEndVisit(_node); }
+	void endVisit(Block const& _node) override { forwardEndVisit(_node); }
+	void endVisit(PlaceholderStatement const& _node) override { forwardEndVisit(_node); }
+	void endVisit(IfStatement const& _node) override { forwardEndVisit(_node); }
+	void endVisit(TryCatchClause const& _node) override { forwardEndVisit(_node); }
+	void endVisit(TryStatement const& _node) override { forwardEndVisit(_node); }
+	void endVisit(WhileStatement const& _node) override { forwardEndVisit(_node); }
+	void endVisit(ForStatement const& _node) override { forwardEndVisit(_node); }
+	void endVisit(Continue const& _node) override { forwardEndVisit(_node); }
+	void endVisit(InlineAssembly const& _node) override { forwardEndVisit(_node); }
+	void endVisit(Break const& _node) override { forwardEndVisit(_node); }
+	void endVisit(Return const& _node) override { forwardEndVisit(_node); }
+	void endVisit(Throw const& _node) override { forwardEndVisit(_node); }
+	void endVisit(EmitStatement const& _node) override { forwardEndVisit(_node); }
+	void endVisit(VariableDeclarationStatement const& _node) override { forwardEndVisit(_node); }
+	void endVisit(ExpressionStatement const& _node) override { forwardEndVisit(_node); }
+	void endVisit(Conditional const& _node) override { forwardEndVisit(_node); }
+	void endVisit(Assignment const& _node) override { forwardEndVisit(_node); }
+	void endVisit(TupleExpression const& _node) override { forwardEndVisit(_node); }
+	void endVisit(UnaryOperation const& _node) override { forwardEndVisit(_node); }
+	void endVisit(BinaryOperation const& _node) override { forwardEndVisit(_node); }
+	void endVisit(FunctionCall const& _node) override { forwardEndVisit(_node); }
+	void endVisit(FunctionCallOptions const& _node) override { forwardEndVisit(_node); }
+	void endVisit(NewExpression const& _node) override { forwardEndVisit(_node); }
+	void endVisit(MemberAccess const& _node) override { forwardEndVisit(_node); }
+	void endVisit(IndexAccess const& _node) override { forwardEndVisit(_node); }
+	void endVisit(IndexRangeAccess const& _node) override { forwardEndVisit(_node); }
+	void endVisit(Identifier const& _node) override { forwardEndVisit(_node); }
+	void endVisit(ElementaryTypeNameExpression const& _node) override { forwardEndVisit(_node); }
+	void endVisit(Literal const& _node) override { forwardEndVisit(_node); }
+	void endVisit(StructuredDocumentation const& _node) override { forwardEndVisit(_node); }
+
+	template <class T>
+	bool forwardVisit(T const& _node);
+	template <class T>
+	void forwardEndVisit(T const& _node);
+
+	std::vector<std::unique_ptr<Step>> m_steps;
+};
+
+template <class T>
+inline bool FusedAnalysis::forwardVisit(T const& _node)
+{
+	bool visitChildren = false;
+	for (auto& step: m_steps)
+		if (!step->failed && !step->suspendedAt)
+		{
+			try
+			{
+				if (step->analysis->visitor().visit(_node))
+					visitChildren = true;
+				else
+					step->suspendedAt = &_node;
+			}
+			catch (langutil::FatalError const&)
+			{
+				step->failed = true;
+			}
+		}
+	return visitChildren;
+}
+
+template <class T>
+inline void FusedAnalysis::forwardEndVisit(T const& _node)
+{
+	for (auto& step: m_steps)
+		if (!step->failed && (!step->suspendedAt || step->suspendedAt == &_node))
+		{
+			step->suspendedAt = nullptr;
+			try
+			{
+				step->analysis->visitor().endVisit(_node);
+			}
+			catch (langutil::FatalError const&)
+			{
+				step->failed = true;
+			}
+		}
+}
+
+}
@@ -39,9 +39,8 @@ using namespace solidity::langutil;
 using namespace solidity::frontend;
 
 
-bool SyntaxChecker::checkSyntax(ASTNode const& _astRoot)
+bool SyntaxChecker::endSourceUnit(SourceUnit const&)
 {
-	_astRoot.accept(*this);
 	return Error::containsOnlyWarnings(m_errorReporter.errors());
 }
 
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <libsolidity/analysis/FusedAnalysis.h>
 #include <libsolidity/analysis/TypeChecker.h>
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/ast/ASTAnnotations.h>
@@ -39,7 +40,7 @@ namespace solidity::frontend
  *  - issues deprecation warning for throw
  *  - whether the msize instruction is used and the Yul optimizer is enabled at the same time.
  */
-class SyntaxChecker: private ASTConstVisitor
+class SyntaxChecker: private ASTConstVisitor, public FusableAnalysis
 {
 public:
 	/// @param _errorReporter provides the error logging functionality.
@@ -48,7 +49,8 @@ public:
 		m_useYulOptimizer(_useYulOptimizer)
 	{}
 
-	bool checkSyntax(ASTNode const& _astRoot);
+	bool endSourceUnit(SourceUnit const& _sourceUnit) override;
+	ASTConstVisitor& visitor() override { return *this; }
 
 private:
 
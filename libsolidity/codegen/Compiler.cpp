@@ -24,6 +24,7 @@
 
 #include <libsolidity/codegen/ContractCompiler.h>
 #include <libevmasm/Assembly.h>
+#include <libsolutil/AllocationStatistics.h>
 
 using namespace std;
 using namespace solidity;
@@ -48,6 +49,7 @@ void Compiler::compileContract(
 	ContractCompiler creationCompiler(&runtimeCompiler, m_context, creationSettings);
 	m_runtimeSub = creationCompiler.compileConstructor(_contract, _otherCompilers);
 
+	util::ScopedAllocationPhase allocationPhase("evmasmOptimizer");
 	m_context.optimise(m_optimiserSettings);
 }
 
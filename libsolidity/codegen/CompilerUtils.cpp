@@ -27,6 +27,7 @@
 #include <libsolidity/codegen/ABIFunctions.h>
 #include <libsolidity/codegen/ArrayUtils.h>
 #include <libsolidity/codegen/LValue.h>
+#include <libevmasm/GasMeter.h>
 #include <libevmasm/Instruction.h>
 #include <libsolutil/Whiskers.h>
 
@@ -606,13 +607,23 @@ void CompilerUtils::memoryCopy32()
 {
 	// Stack here: size target source
 
-	m_context.appendInlineAssembly(R"(
-		{
-			for { let i := 0 } lt(i, len) { i := add(i, 32) } {
-				mstore(add(dst, i), mload(add(src, i)))
+	m_context.appendInlineAssembly(
+		Whiskers(R"(
+			{
+				switch lt(len, <threshold>)
+				case 0 {
+					<identityCopy>
+				}
+				default {
+					for { let i := 0 } lt(i, len) { i := add(i, 32) } {
+						mstore(add(dst, i), mload(add(src, i)))
+					}
+				}
 			}
-		}
-	)",
+		)")
+		("threshold", to_string(identityCopyThreshold(m_context.evmVersion())))
+		("identityCopy", identityCopyCode(m_context.evmVersion(), "src", "dst", "len"))
+		.render(),
 		{ "len", "dst", "src" }
 	);
 	m_context << Instruction::POP << Instruction::POP << Instruction::POP;
@@ -622,26 +633,36 @@ void CompilerUtils::memoryCopy()
 {
 	// Stack here: size target source
 
-	m_context.appendInlineAssembly(R"(
-		{
-			// copy 32 bytes at once
-			for
-				{}
-				iszero(lt(len, 32))
-				{
-					dst := add(dst, 32)
-					src := add(src, 32)
-					len := sub(len, 32)
+	m_context.appendInlineAssembly(
+		Whiskers(R"(
+			{
+				switch lt(len, <threshold>)
+				case 0 {
+					<identityCopy>
 				}
-				{ mstore(dst, mload(src)) }
-
-			// copy the remainder (0 < len < 32)
-			let mask := sub(exp(256, sub(32, len)), 1)
-			let srcpart := and(mload(src), not(mask))
-			let dstpart := and(mload(dst), mask)
-			mstore(dst, or(srcpart, dstpart))
-		}
-	)",
+				default {
+					// copy 32 bytes at once
+					for
+						{}
+						iszero(lt(len, 32))
+						{
+							dst := add(dst, 32)
+							src := add(src, 32)
+							len := sub(len, 32)
+						}
+						{ mstore(dst, mload(src)) }
+
+					// copy the remainder (0 < len < 32)
+					let mask := sub(exp(256, sub(32, len)), 1)
+					let srcpart := and(mload(src), not(mask))
+					let dstpart := and(mload(dst), mask)
+					mstore(dst, or(srcpart, dstpart))
+				}
+			}
+		)")
+		("threshold", to_string(identityCopyThreshold(m_context.evmVersion())))
+		("identityCopy", identityCopyCode(m_context.evmVersion(), "src", "dst", "len"))
+		.render(),
 		{ "len", "dst", "src" }
 	);
 	m_context << Instruction::POP << Instruction::POP << Instruction::POP;
@@ -1313,6 +1334,41 @@ unsigned CompilerUtils::sizeOnStack(vector<Type const*> const& _variableTypes)
 	return size;
 }
 
+unsigned CompilerUtils::identityCopyThreshold(EVMVersion _evmVersion)
+{
+	// A word copied in a loop costs about 75 gas (including the loop overhead),
+	// while the call costs a fixed amount plus the word gas of the precompile.
+	unsigned const loopWordGas = 75;
+	unsigned const callOverhead = GasCosts::callGas(_evmVersion) + GasCosts::identityGas + 40;
+	return 32 * (callOverhead / (loopWordGas - GasCosts::identityWordGas) + 1);
+}
+
+string CompilerUtils::identityCopyCode(
+	EVMVersion _evmVersion,
+	string const& _src,
+	string const& _dst,
+	string const& _length
+)
+{
+	// Before Tangerine Whistle, a call fails if it requests more gas than is available,
+	// so only the gas needed by the precompile is requested.
+	string gas = "gas()";
+	if (!_evmVersion.canOverchargeGasForCall())
+		gas = Whiskers("add(<identityGas>, mul(<identityWordGas>, div(add(<length>, 31), 32)))")
+			("identityGas", to_string(GasCosts::identityGas))
+			("identityWordGas", to_string(GasCosts::identityWordGas))
+			("length", _length)
+			.render();
+	return Whiskers(R"(if iszero(<call>(<gas>, 4, <value><src>, <length>, <dst>, <length>)) { revert(0, 0) })")
+	("call", _evmVersion.hasStaticCall() ? "staticcall" : "call")
+	("gas", gas)
+	("value", _evmVersion.hasStaticCall() ? "" : "0, ")
+	("src", _src)
+	("dst", _dst)
+	("length", _length)
+	.render();
+}
+
 void CompilerUtils::computeHashStatic()
 {
 	storeInMemory(0);
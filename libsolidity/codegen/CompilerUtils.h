@@ -195,11 +195,13 @@ public:
 
 	/// Copies full 32 byte words in memory (regions cannot overlap), i.e. may copy more than length.
 	/// Length can be zero, in this case, it copies nothing.
+	/// Uses the identity precompile for lengths of at least identityCopyThreshold() bytes.
 	/// Stack pre: <size> <target> <source>
 	/// Stack post:
 	void memoryCopy32();
 	/// Copies data in memory (regions cannot overlap).
 	/// Length can be zero, in this case, it copies nothing.
+	/// Uses the identity precompile for lengths of at least identityCopyThreshold() bytes.
 	/// Stack pre: <size> <target> <source>
 	/// Stack post:
 	void memoryCopy();
@@ -273,6 +275,19 @@ public:
 	static unsigned sizeOnStack(std::vector<T> const& _variables);
 	static unsigned sizeOnStack(std::vector<Type const*> const& _variableTypes);
 
+	/// @returns the number of bytes starting from which copying memory using a call to the
+	/// identity precompile is cheaper than copying it word by word.
+	static unsigned identityCopyThreshold(langutil::EVMVersion _evmVersion);
+	/// @returns code that copies @a _length bytes in memory from @a _src to @a _dst by calling
+	/// the identity precompile and reverts if the call fails.
+	/// Before Tangerine Whistle, the call only requests the gas needed by the precompile.
+	static std::string identityCopyCode(
+		langutil::EVMVersion _evmVersion,
+		std::string const& _src,
+		std::string const& _dst,
+		std::string const& _length
+	);
+
 	/// Helper function to shift top value on the stack to the left.
 	/// Stack pre: <value> <shift_by_bits>
 	/// Stack post: <shifted_value>
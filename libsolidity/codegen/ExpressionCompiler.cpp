@@ -782,16 +782,28 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 			// but directly compute keccak256 on memory.
 			if (*argType == *TypeProvider::bytesMemory() || *argType == *TypeProvider::stringMemory())
 			{
+				// The result of abi.encode is not referenced anywhere else, so its memory
+				// can be released again after hashing. This avoids memory expansion if the
+				// hash is computed repeatedly, e.g. inside a loop.
+				bool releaseMemory = isABIEncodingCall(*arguments.front());
+				if (releaseMemory)
+					m_context << Instruction::DUP1;
 				ArrayUtils(m_context).retrieveLength(*TypeProvider::bytesMemory());
 				m_context << Instruction::SWAP1 << u256(0x20) << Instruction::ADD;
+				m_context << Instruction::KECCAK256;
+				if (releaseMemory)
+				{
+					m_context << Instruction::SWAP1;
+					utils().storeFreeMemoryPointer();
+				}
 			}
 			else
 			{
 				utils().fetchFreeMemoryPointer();
 				utils().packedEncode({argType}, TypePointers());
 				utils().toSizeAfterFreeMemoryPointer();
+				m_context << Instruction::KECCAK256;
 			}
-			m_context << Instruction::KECCAK256;
 			break;
 		}
 		case FunctionType::Kind::Log0:
@@ -2461,6 +2473,26 @@ void ExpressionCompiler::setLValueToStorageItem(Expression const& _expression)
 	setLValue<StorageItem>(_expression, *_expression.annotation().type);
 }
 
+bool ExpressionCompiler::isABIEncodingCall(Expression const& _expression)
+{
+	auto const* functionCall = dynamic_cast<FunctionCall const*>(&_expression);
+	if (!functionCall || functionCall->annotation().kind != FunctionCallKind::FunctionCall)
+		return false;
+	auto const* functionType = dynamic_cast<FunctionType const*>(functionCall->expression().annotation().type);
+	if (!functionType)
+		return false;
+	switch (functionType->kind())
+	{
+	case FunctionType::Kind::ABIEncode:
+	case FunctionType::Kind::ABIEncodePacked:
+	case FunctionType::Kind::ABIEncodeWithSelector:
+	case FunctionType::Kind::ABIEncodeWithSignature:
+		return true;
+	default:
+		return false;
+	}
+}
+
 bool ExpressionCompiler::cleanupNeededForOp(Type::Category _type, Token _op)
 {
 	if (TokenTraits::isCompareOp(_op) || TokenTraits::isShiftOp(_op))
@@ -132,6 +132,10 @@ private:
 	/// operation.
 	static bool cleanupNeededForOp(Type::Category _type, Token _op);
 
+	/// @returns true if @a _expression is a call to one of the ``abi.encode`` functions,
+	/// i.e. if its value is a freshly allocated memory area that was allocated last.
+	static bool isABIEncodingCall(Expression const& _expression);
+
 	void acceptAndConvert(Expression const& _expression, Type const& _type, bool _cleanupNeeded = false);
 
 	/// @returns the CompilerUtils object containing the current context.
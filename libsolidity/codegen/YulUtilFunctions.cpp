@@ -90,19 +90,32 @@ string YulUtilFunctions::copyToMemoryFunction(bool _fromCalldata)
 		{
 			return Whiskers(R"(
 				function <functionName>(src, dst, length) {
-					let i := 0
-					for { } lt(i, length) { i := add(i, 32) }
-					{
-						mstore(add(dst, i), mload(add(src, i)))
+					switch lt(length, <threshold>)
+					case 0 {
+						<identityCopy>
+						if and(length, 0x1f)
+						{
+							// clear end
+							mstore(add(dst, length), 0)
+						}
 					}
-					if gt(i, length)
-					{
-						// clear end
-						mstore(add(dst, length), 0)
+					default {
+						let i := 0
+						for { } lt(i, length) { i := add(i, 32) }
+						{
+							mstore(add(dst, i), mload(add(src, i)))
+						}
+						if gt(i, length)
+						{
+							// clear end
+							mstore(add(dst, length), 0)
+						}
 					}
 				}
 			)")
 			("functionName", functionName)
+			("threshold", to_string(CompilerUtils::identityCopyThreshold(m_evmVersion)))
+			("identityCopy", CompilerUtils::identityCopyCode(m_evmVersion, "src", "dst", "length"))
 			.render();
 		}
 	});
@@ -48,29 +48,51 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
 
-pair<string, string> IRGenerator::run(ContractDefinition const& _contract)
+namespace
 {
-	string const ir = yul::reindent(generate(_contract));
 
-	yul::AssemblyStack asmStack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	if (!asmStack.parseAndAnalyze("", ir))
+string const irWarning =
+	"/*******************************************************\n"
+	" *                       WARNING                       *\n"
+	" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
+	" *       It can result in LOSS OF FUNDS or worse       *\n"
+	" *                !USE AT YOUR OWN RISK!               *\n"
+	" *******************************************************/\n\n";
+
+void parseAndAnalyzeIR(yul::AssemblyStack& _asmStack, string const& _ir)
+{
+	if (!_asmStack.parseAndAnalyze("", _ir))
 	{
 		string errorMessage;
-		for (auto const& error: asmStack.errors())
+		for (auto const& error: _asmStack.errors())
 			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(*error);
-		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
+		solAssert(false, _ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
 	}
-	asmStack.optimize();
+}
+
+}
 
-	string warning =
-		"/*******************************************************\n"
-		" *                       WARNING                       *\n"
-		" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
-		" *       It can result in LOSS OF FUNDS or worse       *\n"
-		" *                !USE AT YOUR OWN RISK!               *\n"
-		" *******************************************************/\n\n";
+string IRGenerator::run(ContractDefinition const& _contract)
+{
+	string const ir = yul::reindent(generate(_contract));
+
+	yul::AssemblyStack asmStack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
+	parseAndAnalyzeIR(asmStack, ir);
+
+	return irWarning + ir;
+}
+
+string IRGenerator::optimize(
+	string const& _ir,
+	langutil::EVMVersion _evmVersion,
+	OptimiserSettings const& _optimiserSettings
+)
+{
+	yul::AssemblyStack asmStack(_evmVersion, yul::AssemblyStack::Language::StrictAssembly, _optimiserSettings);
+	parseAndAnalyzeIR(asmStack, _ir);
+	asmStack.optimize();
 
-	return {warning + ir, warning + asmStack.print()};
+	return irWarning + asmStack.print();
 }
 
 string IRGenerator::generate(ContractDefinition const& _contract)
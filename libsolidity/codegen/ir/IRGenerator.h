@@ -48,9 +48,16 @@ public:
 		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector())
 	{}
 
-	/// Generates and returns the IR code, in unoptimized and optimized form
+	/// Generates and returns the unoptimized IR code.
+	std::string run(ContractDefinition const& _contract);
+
+	/// @returns the optimized form of the IR code @a _ir returned by run()
 	/// (or just pretty-printed, depending on the optimizer settings).
-	std::pair<std::string, std::string> run(ContractDefinition const& _contract);
+	static std::string optimize(
+		std::string const& _ir,
+		langutil::EVMVersion _evmVersion,
+		OptimiserSettings const& _optimiserSettings
+	);
 
 private:
 	std::string generate(ContractDefinition const& _contract);
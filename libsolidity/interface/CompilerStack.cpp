@@ -28,6 +28,7 @@
 #include <libsolidity/analysis/ControlFlowGraph.h>
 #include <libsolidity/analysis/ContractLevelChecker.h>
 #include <libsolidity/analysis/DocStringAnalyser.h>
+#include <libsolidity/analysis/FusedAnalysis.h>
 #include <libsolidity/analysis/GlobalContext.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
 #include <libsolidity/analysis/PostTypeChecker.h>
@@ -59,6 +60,7 @@
 
 #include <libevmasm/Exceptions.h>
 
+#include <libsolutil/AllocationStatistics.h>
 #include <libsolutil/SwarmHash.h>
 #include <libsolutil/IpfsHash.h>
 #include <libsolutil/JSON.h>
@@ -124,6 +126,32 @@ void CompilerStack::setRemappings(vector<Remapping> const& _remappings)
 	for (auto const& remapping: _remappings)
 		solAssert(!remapping.prefix.empty(), "");
 	m_remappings = _remappings;
+
+	m_remappingTrie = RemappingTrie{};
+	m_resolvedImportPaths.clear();
+	// Later remappings replace earlier ones with the same context and prefix.
+	for (auto const& remapping: m_remappings)
+	{
+		RemappingTrie* node = &m_remappingTrie;
+		for (char c: util::sanitizePath(remapping.context))
+		{
+			auto& child = node->children[c];
+			if (!child)
+				child = make_unique<RemappingTrie>();
+			node = child.get();
+		}
+		if (!node->prefixes)
+			node->prefixes = make_unique<RemappingTrie>();
+		node = node->prefixes.get();
+		for (char c: util::sanitizePath(remapping.prefix))
+		{
+			auto& child = node->children[c];
+			if (!child)
+				child = make_unique<RemappingTrie>();
+			node = child.get();
+		}
+		node->target = util::sanitizePath(remapping.target);
+	}
 }
 
 void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
@@ -200,9 +228,12 @@ void CompilerStack::reset(bool _keepSettings)
 	if (!_keepSettings)
 	{
 		m_remappings.clear();
+		m_remappingTrie = RemappingTrie{};
+		m_resolvedImportPaths.clear();
 		m_libraries.clear();
 		m_evmVersion = langutil::EVMVersion();
 		m_enabledSMTSolvers = smt::SMTSolverChoice::All();
+		m_compiledContractNames.clear();
 		m_generateIR = false;
 		m_generateEwasm = false;
 		m_revertStrings = RevertStrings::Default;
@@ -224,16 +255,28 @@ void CompilerStack::setSources(StringMap _sources)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot change sources once set."));
 	if (m_stackState != Empty)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set sources before parsing."));
-	for (auto source: _sources)
+	for (auto& source: _sources)
 		m_sources[source.first].scanner = make_shared<Scanner>(CharStream(/*content*/std::move(source.second), /*name*/source.first));
 	m_stackState = SourcesSet;
 }
 
+void CompilerStack::setSourceFiles(map<string, shared_ptr<util::MappedFile const>> _files)
+{
+	if (m_stackState == SourcesSet)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot change sources once set."));
+	if (m_stackState != Empty)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set sources before parsing."));
+	for (auto& [name, file]: _files)
+		m_sources[name].scanner = make_shared<Scanner>(CharStream(std::move(file), name));
+	m_stackState = SourcesSet;
+}
+
 bool CompilerStack::parse()
 {
 	if (m_stackState != SourcesSet)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call parse only after the SourcesSet state."));
 	m_errorReporter.clear();
+	util::ScopedAllocationPhase allocationPhase("parsing");
 
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning("This is a pre-release compiler version, please do not use it in production.");
@@ -254,11 +297,10 @@ bool CompilerStack::parse()
 		else
 		{
 			source.ast->annotation().path = path;
-			for (auto const& newSource: loadMissingSources(*source.ast, path))
+			for (auto& newSource: loadMissingSources(*source.ast, path))
 			{
 				string const& newPath = newSource.first;
-				string const& newContents = newSource.second;
-				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
+				m_sources[newPath].scanner = make_shared<Scanner>(std::move(newSource.second));
 				sourcesToParse.push_back(newPath);
 			}
 		}
@@ -294,21 +336,28 @@ bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsingPerformed || m_stackState >= AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call analyze only after parsing was performed."));
+	util::ScopedAllocationPhase allocationPhase("analysis");
 	resolveImports();
 
 	bool noErrors = true;
 
 	try
 	{
-		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
+		vector<SourceUnit const*> sourceUnits;
 		for (Source const* source: m_sourceOrder)
-			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
-
-		DocStringAnalyser docStringAnalyser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
-				noErrors = false;
+			if (source->ast)
+				sourceUnits.push_back(source->ast.get());
+
+		// The syntax checker and the docstring analyser do not depend on each other,
+		// so they share a single traversal of the AST.
+		FusedAnalysis syntacticAnalysis;
+		syntacticAnalysis.add<SyntaxChecker>(m_optimiserSettings.runYulOptimiser);
+		syntacticAnalysis.add<DocStringAnalyser>();
+		if (!syntacticAnalysis.run(sourceUnits, m_errorReporter))
+			noErrors = false;
+		// Errors reported before the analysis, e.g. by the parser, fail the syntax check.
+		if (!Error::containsOnlyWarnings(m_errorReporter.errors()))
+			noErrors = false;
 
 		m_globalContext = make_shared<GlobalContext>();
 		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_scopes, m_errorReporter);
@@ -461,16 +510,17 @@ bool CompilerStack::isRequestedSource(string const& _sourceName) const
 		m_requestedContractNames.count(_sourceName);
 }
 
-bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) const
+namespace
 {
-	/// In case nothing was specified in outputSelection.
-	if (m_requestedContractNames.empty())
-		return true;
 
+/// @returns true if @a _contract is contained in @a _contractNames, where the empty string
+/// matches any source unit or contract name.
+bool containsContract(map<string, set<string>> const& _contractNames, ContractDefinition const& _contract)
+{
 	for (auto const& key: vector<string>{"", _contract.sourceUnitName()})
 	{
-		auto const& it = m_requestedContractNames.find(key);
-		if (it != m_requestedContractNames.end())
+		auto const& it = _contractNames.find(key);
+		if (it != _contractNames.end())
 			if (it->second.count(_contract.name()) || it->second.count(""))
 				return true;
 	}
@@ -478,6 +528,25 @@ bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) con
 	return false;
 }
 
+}
+
+bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) const
+{
+	/// In case nothing was specified in outputSelection.
+	if (m_requestedContractNames.empty())
+		return true;
+
+	return containsContract(m_requestedContractNames, _contract);
+}
+
+bool CompilerStack::isCompiledContract(ContractDefinition const& _contract) const
+{
+	if (!isRequestedContract(_contract))
+		return false;
+
+	return m_compiledContractNames.empty() || containsContract(m_compiledContractNames, _contract);
+}
+
 bool CompilerStack::compile()
 {
 	if (m_stackState < AnalysisPerformed)
@@ -487,12 +556,13 @@ bool CompilerStack::compile()
 	if (m_hasError)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called compile with errors."));
 
-	// Only compile contracts individually which have been requested.
+	// Only compile contracts individually which have been requested and need code.
+	// Their dependencies are compiled as part of compileContract.
 	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
-				if (isRequestedContract(*contract))
+				if (isCompiledContract(*contract))
 				{
 					compileContract(*contract, otherCompilers);
 					if (m_generateIR || m_generateEwasm)
@@ -561,13 +631,12 @@ string const* CompilerStack::sourceMapping(string const& _contractName) const
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
-	Contract const& c = contract(_contractName);
-	if (!c.sourceMapping)
-	{
-		if (auto items = assemblyItems(_contractName))
-			c.sourceMapping = make_unique<string>(evmasm::AssemblyItem::computeSourceMapping(*items, sourceIndices()));
-	}
-	return c.sourceMapping.get();
+	auto items = assemblyItems(_contractName);
+	if (!items)
+		return nullptr;
+	return &contract(_contractName).sourceMapping.init([&]() {
+		return evmasm::AssemblyItem::computeSourceMapping(*items, sourceIndices());
+	});
 }
 
 string const* CompilerStack::runtimeSourceMapping(string const& _contractName) const
@@ -575,15 +644,12 @@ string const* CompilerStack::runtimeSourceMapping(string const& _contractName) c
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
-	Contract const& c = contract(_contractName);
-	if (!c.runtimeSourceMapping)
-	{
-		if (auto items = runtimeAssemblyItems(_contractName))
-			c.runtimeSourceMapping = make_unique<string>(
-				evmasm::AssemblyItem::computeSourceMapping(*items, sourceIndices())
-			);
-	}
-	return c.runtimeSourceMapping.get();
+	auto items = runtimeAssemblyItems(_contractName);
+	if (!items)
+		return nullptr;
+	return &contract(_contractName).runtimeSourceMapping.init([&]() {
+		return evmasm::AssemblyItem::computeSourceMapping(*items, sourceIndices());
+	});
 }
 
 std::string const CompilerStack::filesystemFriendlyName(string const& _contractName) const
@@ -623,7 +689,17 @@ string const& CompilerStack::yulIROptimized(string const& _contractName) const
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
-	return contract(_contractName).yulIROptimized;
+	return optimizedIR(contract(_contractName));
+}
+
+string const& CompilerStack::optimizedIR(Contract const& _contract) const
+{
+	if (_contract.yulIR.empty())
+		return _contract.yulIR;
+	return _contract.yulIROptimized.init([&]() {
+		util::ScopedAllocationPhase allocationPhase("irGeneration", _contract.contract->fullyQualifiedName());
+		return IRGenerator::optimize(_contract.yulIR, m_evmVersion, m_optimiserSettings);
+	});
 }
 
 string const& CompilerStack::ewasm(string const& _contractName) const
@@ -659,7 +735,7 @@ evmasm::LinkerObject const& CompilerStack::runtimeObject(string const& _contract
 }
 
 /// TODO: cache this string
-string CompilerStack::assemblyString(string const& _contractName, StringMap _sourceCodes) const
+string CompilerStack::assemblyString(string const& _contractName, StringMap const& _sourceCodes) const
 {
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
@@ -671,7 +747,6 @@ string CompilerStack::assemblyString(string const& _contractName, StringMap _sou
 		return string();
 }
 
-/// TODO: cache the JSON
 Json::Value CompilerStack::assemblyJSON(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
@@ -716,11 +791,7 @@ Json::Value const& CompilerStack::contractABI(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
-	// caches the result
-	if (!_contract.abi)
-		_contract.abi = make_unique<Json::Value>(ABI::generate(*_contract.contract));
-
-	return *_contract.abi;
+	return _contract.abi.init([&]() { return ABI::generate(*_contract.contract); });
 }
 
 Json::Value const& CompilerStack::storageLayout(string const& _contractName) const
@@ -738,11 +809,7 @@ Json::Value const& CompilerStack::storageLayout(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
-	// caches the result
-	if (!_contract.storageLayout)
-		_contract.storageLayout = make_unique<Json::Value>(StorageLayout().generate(*_contract.contract));
-
-	return *_contract.storageLayout;
+	return _contract.storageLayout.init([&]() { return StorageLayout().generate(*_contract.contract); });
 }
 
 Json::Value const& CompilerStack::natspecUser(string const& _contractName) const
@@ -760,11 +827,7 @@ Json::Value const& CompilerStack::natspecUser(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
-	// caches the result
-	if (!_contract.userDocumentation)
-		_contract.userDocumentation = make_unique<Json::Value>(Natspec::userDocumentation(*_contract.contract));
-
-	return *_contract.userDocumentation;
+	return _contract.userDocumentation.init([&]() { return Natspec::userDocumentation(*_contract.contract); });
 }
 
 Json::Value const& CompilerStack::natspecDev(string const& _contractName) const
@@ -782,11 +845,7 @@ Json::Value const& CompilerStack::natspecDev(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
-	// caches the result
-	if (!_contract.devDocumentation)
-		_contract.devDocumentation = make_unique<Json::Value>(Natspec::devDocumentation(*_contract.contract));
-
-	return *_contract.devDocumentation;
+	return _contract.devDocumentation.init([&]() { return Natspec::devDocumentation(*_contract.contract); });
 }
 
 Json::Value CompilerStack::methodIdentifiers(string const& _contractName) const
@@ -815,11 +874,7 @@ string const& CompilerStack::metadata(Contract const& _contract) const
 
 	solAssert(_contract.contract, "");
 
-	// cache the result
-	if (!_contract.metadata)
-		_contract.metadata = make_unique<string>(createMetadata(_contract));
-
-	return *_contract.metadata;
+	return _contract.metadata.init([&]() { return createMetadata(_contract); });
 }
 
 Scanner const& CompilerStack::scanner(string const& _sourceName) const
@@ -885,7 +940,10 @@ tuple<int, int, int, int> CompilerStack::positionFromSourceLocation(SourceLocati
 h256 const& CompilerStack::Source::keccak256() const
 {
 	if (keccak256HashCached == h256{})
-		keccak256HashCached = util::keccak256(scanner->source());
+	{
+		string_view source = scanner->source();
+		keccak256HashCached = util::keccak256(bytesConstRef(reinterpret_cast<uint8_t const*>(source.data()), source.size()));
+	}
 	return keccak256HashCached;
 }
 
@@ -903,10 +961,10 @@ string const& CompilerStack::Source::ipfsUrl() const
 	return ipfsUrlCached;
 }
 
-StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string const& _sourcePath)
+map<string, CharStream> CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string const& _sourcePath)
 {
 	solAssert(m_stackState < ParsingPerformed, "");
-	StringMap newSources;
+	map<string, CharStream> newSources;
 	try
 	{
 		for (auto const& node: _ast.nodes())
@@ -914,11 +972,7 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string
 			{
 				solAssert(!import->path().empty(), "Import path cannot be empty.");
 
-				string importPath = util::absolutePath(import->path(), _sourcePath);
-				// The current value of `path` is the absolute path as seen from this source file.
-				// We first have to apply remappings before we can store the actual absolute path
-				// as seen globally.
-				importPath = applyRemapping(importPath, _sourcePath);
+				string const& importPath = resolveImportPath(import->path(), _sourcePath);
 				import->annotation().absolutePath = importPath;
 				if (m_sources.count(importPath) || newSources.count(importPath))
 					continue;
@@ -927,8 +981,10 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string
 				if (m_readFile)
 					result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPath);
 
-				if (result.success)
-					newSources[importPath] = result.responseOrErrorMessage;
+				if (result.success && result.file)
+					newSources.emplace(importPath, CharStream(std::move(result.file), importPath));
+				else if (result.success)
+					newSources.emplace(importPath, CharStream(std::move(result.responseOrErrorMessage), importPath));
 				else
 				{
 					m_errorReporter.parserError(
@@ -946,46 +1002,55 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string
 	return newSources;
 }
 
-string CompilerStack::applyRemapping(string const& _path, string const& _context)
+string const& CompilerStack::resolveImportPath(string const& _importPath, string const& _sourcePath)
+{
+	auto [it, inserted] = m_resolvedImportPaths.try_emplace({_importPath, _sourcePath});
+	if (inserted)
+		// The absolute path as seen from the source file has to be remapped
+		// to obtain the absolute path as seen globally.
+		it->second = applyRemapping(util::absolutePath(_importPath, _sourcePath), _sourcePath);
+	return it->second;
+}
+
+string CompilerStack::applyRemapping(string const& _path, string const& _context) const
 {
 	solAssert(m_stackState < ParsingPerformed, "");
-	// Try to find the longest prefix match in all remappings that are active in the current context.
-	auto isPrefixOf = [](string const& _a, string const& _b)
+	// Collect the prefix tries of all contexts that are a prefix of the current context,
+	// from the shortest to the longest context.
+	vector<RemappingTrie const*> contexts;
+	RemappingTrie const* node = &m_remappingTrie;
+	for (size_t i = 0; node; ++i)
 	{
-		if (_a.length() > _b.length())
-			return false;
-		return std::equal(_a.begin(), _a.end(), _b.begin());
-	};
-
-	size_t longestPrefix = 0;
-	size_t longestContext = 0;
-	string bestMatchTarget;
+		if (node->prefixes)
+			contexts.push_back(node->prefixes.get());
+		if (i == _context.size())
+			break;
+		auto child = node->children.find(_context[i]);
+		node = child == node->children.end() ? nullptr : child->second.get();
+	}
 
-	for (auto const& redir: m_remappings)
+	// A match in a longer context takes precedence over a longer prefix match.
+	for (auto context = contexts.rbegin(); context != contexts.rend(); ++context)
 	{
-		string context = util::sanitizePath(redir.context);
-		string prefix = util::sanitizePath(redir.prefix);
-
-		// Skip if current context is closer
-		if (context.length() < longestContext)
-			continue;
-		// Skip if redir.context is not a prefix of _context
-		if (!isPrefixOf(context, _context))
-			continue;
-		// Skip if we already have a closer prefix match.
-		if (prefix.length() < longestPrefix && context.length() == longestContext)
-			continue;
-		// Skip if the prefix does not match.
-		if (!isPrefixOf(prefix, _path))
-			continue;
-
-		longestContext = context.length();
-		longestPrefix = prefix.length();
-		bestMatchTarget = util::sanitizePath(redir.target);
+		size_t longestPrefix = 0;
+		string const* bestMatchTarget = nullptr;
+		node = *context;
+		for (size_t i = 0; node; ++i)
+		{
+			if (node->target)
+			{
+				longestPrefix = i;
+				bestMatchTarget = &*node->target;
+			}
+			if (i == _path.size())
+				break;
+			auto child = node->children.find(_path[i]);
+			node = child == node->children.end() ? nullptr : child->second.get();
+		}
+		if (bestMatchTarget)
+			return *bestMatchTarget + _path.substr(longestPrefix);
 	}
-	string path = bestMatchTarget;
-	path.append(_path.begin() + longestPrefix, _path.end());
-	return path;
+	return _path;
 }
 
 void CompilerStack::resolveImports()
@@ -1046,6 +1111,7 @@ void CompilerStack::compileContract(
 		compileContract(*dependency, _otherCompilers);
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	util::ScopedAllocationPhase allocationPhase("codegen", _contract.fullyQualifiedName());
 
 	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
 	compiledContract.compiler = compiler;
@@ -1119,8 +1185,9 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	for (auto const* dependency: _contract.annotation().contractDependencies)
 		generateIR(*dependency);
 
+	util::ScopedAllocationPhase allocationPhase("irGeneration", _contract.fullyQualifiedName());
 	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(_contract);
+	compiledContract.yulIR = generator.run(_contract);
 }
 
 void CompilerStack::generateEwasm(ContractDefinition const& _contract)
@@ -1130,13 +1197,15 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called generateEwasm with errors."));
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
+	solAssert(!compiledContract.yulIR.empty(), "");
 	if (!compiledContract.ewasm.empty())
 		return;
 
+	util::ScopedAllocationPhase allocationPhase("ewasm", _contract.fullyQualifiedName());
+
 	// Re-parse the Yul IR in EVM dialect
 	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
+	stack.parseAndAnalyze("", optimizedIR(compiledContract));
 
 	stack.optimize();
 	stack.translate(yul::AssemblyStack::Language::Ewasm);
@@ -1203,24 +1272,6 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 	for (auto const sourceUnit: _contract.contract->sourceUnit().referencedSourceUnits(true))
 		referencedSources.insert(sourceUnit->annotation().path);
 
-	meta["sources"] = Json::objectValue;
-	for (auto const& s: m_sources)
-	{
-		if (!referencedSources.count(s.first))
-			continue;
-
-		solAssert(s.second.scanner, "Scanner not available");
-		meta["sources"][s.first]["keccak256"] = "0x" + toHex(s.second.keccak256().asBytes());
-		if (m_metadataLiteralSources)
-			meta["sources"][s.first]["content"] = s.second.scanner->source();
-		else
-		{
-			meta["sources"][s.first]["urls"] = Json::arrayValue;
-			meta["sources"][s.first]["urls"].append("bzz-raw://" + toHex(s.second.swarmHash().asBytes()));
-			meta["sources"][s.first]["urls"].append(s.second.ipfsUrl());
-		}
-	}
-
 	static_assert(sizeof(m_optimiserSettings.expectedExecutionsPerDeployment) <= sizeof(Json::LargestUInt), "Invalid word size.");
 	solAssert(static_cast<Json::LargestUInt>(m_optimiserSettings.expectedExecutionsPerDeployment) < std::numeric_limits<Json::LargestUInt>::max(), "");
 	meta["settings"]["optimizer"]["runs"] = Json::Value(Json::LargestUInt(m_optimiserSettings.expectedExecutionsPerDeployment));
@@ -1241,6 +1292,7 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 		details["jumpdestRemover"] = m_optimiserSettings.runJumpdestRemover;
 		details["peephole"] = m_optimiserSettings.runPeephole;
 		details["deduplicate"] = m_optimiserSettings.runDeduplicate;
+		details["jumpThreader"] = m_optimiserSettings.runJumpThreader;
 		details["cse"] = m_optimiserSettings.runCSE;
 		details["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
 		details["yul"] = m_optimiserSettings.runYulOptimiser;
@@ -1281,7 +1333,49 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 	meta["output"]["userdoc"] = natspecUser(_contract);
 	meta["output"]["devdoc"] = natspecDev(_contract);
 
-	return util::jsonCompactPrint(meta);
+	// The sources are written directly to the output, so that at most one of them is copied
+	// into a JSON value at a time when their contents are included.
+	ostringstream output;
+	util::JsonCompactStreamWriter writer(output);
+	auto writeSources = [&]()
+	{
+		writer.beginObject("sources");
+		for (auto const& s: m_sources)
+		{
+			if (!referencedSources.count(s.first))
+				continue;
+
+			solAssert(s.second.scanner, "Scanner not available");
+			writer.beginObject(s.first);
+			if (m_metadataLiteralSources)
+				writer.member("content", string(s.second.scanner->source()));
+			writer.member("keccak256", "0x" + toHex(s.second.keccak256().asBytes()));
+			if (!m_metadataLiteralSources)
+			{
+				Json::Value urls{Json::arrayValue};
+				urls.append("bzz-raw://" + toHex(s.second.swarmHash().asBytes()));
+				urls.append(s.second.ipfsUrl());
+				writer.member("urls", urls);
+			}
+			writer.endObject();
+		}
+		writer.endObject();
+	};
+	// The members have to be written in the order of their keys.
+	bool sourcesWritten = false;
+	for (string const& key: meta.getMemberNames())
+	{
+		if (!sourcesWritten && key > "sources")
+		{
+			writeSources();
+			sourcesWritten = true;
+		}
+		writer.member(key, meta[key]);
+	}
+	if (!sourcesWritten)
+		writeSources();
+	writer.finish();
+	return output.str();
 }
 
 class MetadataCBOREncoder
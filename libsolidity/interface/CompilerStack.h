@@ -37,12 +37,16 @@
 
 #include <libsolutil/Common.h>
 #include <libsolutil/FixedHash.h>
+#include <libsolutil/LazyInit.h>
+#include <libsolutil/MappedFile.h>
 
 #include <boost/noncopyable.hpp>
 #include <json/json.h>
 
 #include <functional>
+#include <map>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <set>
 #include <string>
@@ -173,6 +177,14 @@ public:
 		m_requestedContractNames = _contractNames;
 	}
 
+	/// Sets the contracts compile() generates code for, in the same format as the
+	/// requested contract names. Contracts that these contracts create are compiled as well.
+	/// If empty, code is generated for every requested contract.
+	void setCompiledContractNames(std::map<std::string, std::set<std::string>> const& _contractNames = std::map<std::string, std::set<std::string>>{})
+	{
+		m_compiledContractNames = _contractNames;
+	}
+
 	/// Enable experimental generation of Yul IR code.
 	void enableIRGeneration(bool _enable = true) { m_generateIR = _enable; }
 
@@ -190,6 +202,9 @@ public:
 
 	/// Sets the sources. Must be set before parsing.
 	void setSources(StringMap _sources);
+	/// Sets the sources to the contents of @a _files, which are referenced instead of copied.
+	/// Must be set before parsing.
+	void setSourceFiles(std::map<std::string, std::shared_ptr<util::MappedFile const>> _files);
 
 	/// Adds a response to an SMTLib2 query (identified by the hash of the query input).
 	/// Must be set before parsing.
@@ -282,10 +297,9 @@ public:
 	/// @return a verbose text representation of the assembly.
 	/// @arg _sourceCodes is the map of input files to source code strings
 	/// Prerequisite: Successful compilation.
-	std::string assemblyString(std::string const& _contractName, StringMap _sourceCodes = StringMap()) const;
+	std::string assemblyString(std::string const& _contractName, StringMap const& _sourceCodes = StringMap()) const;
 
 	/// @returns a JSON representation of the assembly.
-	/// @arg _sourceCodes is the map of input files to source code strings
 	/// Prerequisite: Successful compilation.
 	Json::Value assemblyJSON(std::string const& _contractName) const;
 
@@ -318,6 +332,7 @@ public:
 	void overwriteReleaseFlag(bool release) { m_release = release; }
 private:
 	/// The state per source unit. Filled gradually during parsing.
+	/// The source text is shared with everything that references it and its hashes are computed at most once.
 	struct Source
 	{
 		std::shared_ptr<langutil::Scanner> scanner;
@@ -332,6 +347,7 @@ private:
 	};
 
 	/// The state per contract. Filled gradually during compilation.
+	/// Artifacts that are not needed to produce the bytecode are only computed when they are first accessed.
 	struct Contract
 	{
 		ContractDefinition const* contract = nullptr;
@@ -339,23 +355,26 @@ private:
 		evmasm::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Experimental Yul IR code.
-		std::string yulIROptimized; ///< Optimized experimental Yul IR code.
 		std::string ewasm; ///< Experimental Ewasm text representation
 		evmasm::LinkerObject ewasmObject; ///< Experimental Ewasm code
-		mutable std::unique_ptr<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
-		mutable std::unique_ptr<Json::Value const> abi;
-		mutable std::unique_ptr<Json::Value const> storageLayout;
-		mutable std::unique_ptr<Json::Value const> userDocumentation;
-		mutable std::unique_ptr<Json::Value const> devDocumentation;
-		mutable std::unique_ptr<std::string const> sourceMapping;
-		mutable std::unique_ptr<std::string const> runtimeSourceMapping;
+		util::LazyInit<std::string> yulIROptimized; ///< Optimized experimental Yul IR code.
+		util::LazyInit<std::string> metadata; ///< The metadata json that will be hashed into the chain.
+		util::LazyInit<Json::Value> abi;
+		util::LazyInit<Json::Value> storageLayout;
+		util::LazyInit<Json::Value> userDocumentation;
+		util::LazyInit<Json::Value> devDocumentation;
+		util::LazyInit<std::string> sourceMapping;
+		util::LazyInit<std::string> runtimeSourceMapping;
 	};
 
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
 	/// @a m_readFile and stores the absolute paths of all imports in the AST annotations.
 	/// @returns the newly loaded sources.
-	StringMap loadMissingSources(SourceUnit const& _ast, std::string const& _path);
-	std::string applyRemapping(std::string const& _path, std::string const& _context);
+	std::map<std::string, langutil::CharStream> loadMissingSources(SourceUnit const& _ast, std::string const& _path);
+	/// @returns the absolute path of the import @a _importPath in the source @a _sourcePath
+	/// after applying the remappings. Results are cached.
+	std::string const& resolveImportPath(std::string const& _importPath, std::string const& _sourcePath);
+	std::string applyRemapping(std::string const& _path, std::string const& _context) const;
 	void resolveImports();
 
 	/// @returns true if the source is requested to be compiled.
@@ -364,6 +383,9 @@ private:
 	/// @returns true if the contract is requested to be compiled.
 	bool isRequestedContract(ContractDefinition const& _contract) const;
 
+	/// @returns true if code has to be generated for the contract by compile().
+	bool isCompiledContract(ContractDefinition const& _contract) const;
+
 	/// Compile a single contract.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
@@ -421,6 +443,10 @@ private:
 	/// This will generate the metadata and store it in the Contract object if it is not present yet.
 	std::string const& metadata(Contract const&) const;
 
+	/// @returns the optimized IR of the contract or an empty string if no IR was generated.
+	/// This will optimize the IR and store it in the Contract object if it is not present yet.
+	std::string const& optimizedIR(Contract const&) const;
+
 	/// @returns the offset of the entry point of the given function into the list of assembly items
 	/// or zero if it is not found or does not exist.
 	size_t functionEntryPoint(
@@ -434,12 +460,25 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	smt::SMTSolverChoice m_enabledSMTSolvers;
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
+	std::map<std::string, std::set<std::string>> m_compiledContractNames;
 	bool m_generateIR;
 	bool m_generateEwasm;
 	std::map<std::string, util::h160> m_libraries;
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
 	std::vector<Remapping> m_remappings;
+	/// Character trie over the sanitized contexts of the remappings. Each node that
+	/// ends a context holds a trie over the sanitized prefixes used in that context,
+	/// whose nodes that end a prefix hold the sanitized target.
+	struct RemappingTrie
+	{
+		std::map<char, std::unique_ptr<RemappingTrie>> children;
+		std::unique_ptr<RemappingTrie> prefixes;
+		std::optional<std::string> target;
+	};
+	RemappingTrie m_remappingTrie;
+	/// Cache of resolved import paths, indexed by import path and importing source.
+	std::map<std::pair<std::string, std::string>, std::string> m_resolvedImportPaths;
 	std::map<std::string const, Source> m_sources;
 	// if imported, store AST-JSONS for each filename
 	std::map<std::string, Json::Value> m_sourceJsons;
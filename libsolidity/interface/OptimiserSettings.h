@@ -50,6 +50,7 @@ struct OptimiserSettings
 		s.runJumpdestRemover = true;
 		s.runPeephole = true;
 		s.runDeduplicate = true;
+		s.runJumpThreader = true;
 		s.runCSE = true;
 		s.runConstantOptimiser = true;
 		s.runYulOptimiser = true;
@@ -70,6 +71,7 @@ struct OptimiserSettings
 			runJumpdestRemover == _other.runJumpdestRemover &&
 			runPeephole == _other.runPeephole &&
 			runDeduplicate == _other.runDeduplicate &&
+			runJumpThreader == _other.runJumpThreader &&
 			runCSE == _other.runCSE &&
 			runConstantOptimiser == _other.runConstantOptimiser &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
@@ -86,6 +88,8 @@ struct OptimiserSettings
 	bool runPeephole = false;
 	/// Assembly block deduplicator
 	bool runDeduplicate = false;
+	/// Jump threading and block layout optimizer.
+	bool runJumpThreader = false;
 	/// Common subexpression eliminator based on assembly items.
 	bool runCSE = false;
 	/// Constant optimizer, which tries to find better representations that satisfy the given
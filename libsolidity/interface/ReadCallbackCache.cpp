@@ -0,0 +1,99 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Cache for the responses of a read callback that is shared between compilations.
+ */
+
+#include <libsolidity/interface/ReadCallbackCache.h>
+
+#include <boost/filesystem.hpp>
+
+#if !defined(_WIN32)
+#include <sys/stat.h>
+#endif
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+ReadCallback::Callback ReadCallbackCache::wrap(ReadCallback::Callback _readFile)
+{
+	if (!_readFile)
+		return _readFile;
+	return [this, readFile = std::move(_readFile)](string const& _kind, string const& _path) -> ReadCallback::Result
+	{
+		if (_kind != ReadCallback::kindString(ReadCallback::Kind::ReadFile))
+			return readFile(_kind, _path);
+
+		optional<string> fingerprint;
+		if (m_fingerprint)
+		{
+			fingerprint = m_fingerprint(_path);
+			if (!fingerprint)
+			{
+				m_entries.erase(_path);
+				return readFile(_kind, _path);
+			}
+		}
+
+		auto entry = m_entries.find(_path);
+		if (entry != m_entries.end() && entry->second.fingerprint == fingerprint)
+			return ReadCallback::Result{true, string(), entry->second.file};
+
+		ReadCallback::Result result = readFile(_kind, _path);
+		if (!result.success)
+		{
+			m_entries.erase(_path);
+			return result;
+		}
+		// Keep the contents in shared storage, so that the compiler and the cache reference
+		// the same copy.
+		if (!result.file)
+			result.file = util::MappedFile::fromContents(std::move(result.responseOrErrorMessage));
+		m_entries[_path] = Entry{std::move(fingerprint), result.file};
+		return ReadCallback::Result{true, string(), std::move(result.file)};
+	};
+}
+
+optional<string> ReadCallbackCache::fileFingerprint(string const& _path)
+{
+#if !defined(_WIN32)
+	struct stat status;
+	if (stat(_path.c_str(), &status) != 0 || !S_ISREG(status.st_mode))
+		return nullopt;
+#if defined(__APPLE__)
+	timespec const& modificationTime = status.st_mtimespec;
+#else
+	timespec const& modificationTime = status.st_mtim;
+#endif
+	return
+		to_string(status.st_size) + ":" +
+		to_string(modificationTime.tv_sec) + "." +
+		to_string(modificationTime.tv_nsec);
+#else
+	boost::system::error_code error;
+	if (!boost::filesystem::is_regular_file(_path, error))
+		return nullopt;
+	auto size = boost::filesystem::file_size(_path, error);
+	if (error)
+		return nullopt;
+	auto modificationTime = boost::filesystem::last_write_time(_path, error);
+	if (error)
+		return nullopt;
+	return to_string(size) + ":" + to_string(modificationTime);
+#endif
+}
@@ -0,0 +1,84 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Cache for the responses of a read callback that is shared between compilations.
+ */
+
+#pragma once
+
+#include <libsolidity/interface/ReadFile.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+
+namespace solidity::frontend
+{
+
+/**
+ * Memoises the files returned by a read callback across compilations in the same process,
+ * so that unchanged dependencies are neither read nor copied again.
+ *
+ * Successful responses to file reads are stored by path together with the fingerprint of
+ * the file at the time it was read. A cached response is only used while the fingerprint
+ * is unchanged. Without a fingerprint function, responses stay valid until they are
+ * invalidated explicitly. Failed reads and other kinds of queries are never cached.
+ *
+ * The cache is not thread-safe and has to outlive the callbacks returned by wrap().
+ */
+class ReadCallbackCache: boost::noncopyable
+{
+public:
+	/// Function that @returns a value that changes whenever the file at the given path changes,
+	/// or nullopt if it cannot be determined, in which case the file is not cached.
+	using Fingerprint = std::function<std::optional<std::string>(std::string const&)>;
+
+	explicit ReadCallbackCache(Fingerprint _fingerprint = Fingerprint()):
+		m_fingerprint(std::move(_fingerprint))
+	{}
+
+	/// @returns a callback that answers file reads from the cache if possible and
+	/// forwards all other requests to @a _readFile. Returns an empty callback if @a _readFile is empty.
+	ReadCallback::Callback wrap(ReadCallback::Callback _readFile);
+
+	/// Removes the response for the file @a _path from the cache.
+	void invalidate(std::string const& _path) { m_entries.erase(_path); }
+	/// Removes all responses from the cache.
+	void clear() { m_entries.clear(); }
+	/// @returns the number of cached files.
+	size_t size() const { return m_entries.size(); }
+
+	/// Fingerprint for regular files in the local filesystem, consisting of their size and
+	/// modification time, or nullopt if there is no such file at @a _path.
+	/// Where supported, the modification time has a resolution of nanoseconds, otherwise of seconds.
+	static std::optional<std::string> fileFingerprint(std::string const& _path);
+
+private:
+	struct Entry
+	{
+		std::optional<std::string> fingerprint;
+		std::shared_ptr<util::MappedFile const> file;
+	};
+
+	Fingerprint m_fingerprint;
+	std::map<std::string, Entry> m_entries;
+};
+
+}
@@ -18,9 +18,11 @@
 #pragma once
 
 #include <liblangutil/Exceptions.h>
+#include <libsolutil/MappedFile.h>
 
 #include <boost/noncopyable.hpp>
 #include <functional>
+#include <memory>
 #include <string>
 
 namespace solidity::frontend
@@ -34,6 +36,8 @@ public:
 	{
 		bool success;
 		std::string responseOrErrorMessage;
+		/// Contents of a file that was read without copying it. If set, they are used instead of the response.
+		std::shared_ptr<util::MappedFile const> file = nullptr;
 	};
 
 	enum class Kind
@@ -27,6 +27,7 @@
 #include <libyul/Exceptions.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 #include <libevmasm/Instruction.h>
+#include <libsolutil/AllocationStatistics.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
 
@@ -35,6 +36,7 @@
 
 #include <algorithm>
 #include <optional>
+#include <sstream>
 
 using namespace std;
 using namespace solidity;
@@ -179,19 +181,18 @@ bool isArtifactRequested(Json::Value const& _outputSelection, string const& _art
 /// @a _outputSelection is a JSON object containining a two-level hashmap, where the first level is the filename,
 /// the second level is the contract name and the value is an array of artifact names to be requested for that contract.
 /// @a _file is the current file
-/// @a _contract is the current contract
-/// @a _artifact is the current artifact name
+/// @a _contract is the current contract, empty for source unit level artifacts
 ///
-/// @returns true if the @a _outputSelection has a match for the requested target in the specific file / contract.
+/// @returns the artifact names requested in @a _outputSelection for the specific file / contract, so that
+/// the selection does not have to be walked again for every artifact.
 ///
 /// In @a _outputSelection the use of '*' as a wildcard is permitted.
 ///
-/// @TODO optimise this. Perhaps flatten the structure upfront.
-///
-bool isArtifactRequested(Json::Value const& _outputSelection, string const& _file, string const& _contract, string const& _artifact, bool _wildcardMatchesExperimental)
+Json::Value requestedArtifacts(Json::Value const& _outputSelection, string const& _file, string const& _contract)
 {
+	Json::Value artifacts(Json::arrayValue);
 	if (!_outputSelection.isObject())
-		return false;
+		return artifacts;
 
 	for (auto const& file: { _file, string("*") })
 		if (_outputSelection.isMember(file) && _outputSelection[file].isObject())
@@ -202,31 +203,39 @@ bool isArtifactRequested(Json::Value const& _outputSelection, string const& _fil
 			if (!_contract.empty())
 				contracts.push_back("*");
 			for (auto const& contract: contracts)
-				if (
-					_outputSelection[file].isMember(contract) &&
-					_outputSelection[file][contract].isArray() &&
-					isArtifactRequested(_outputSelection[file][contract], _artifact, _wildcardMatchesExperimental)
-				)
-					return true;
+				if (_outputSelection[file].isMember(contract) && _outputSelection[file][contract].isArray())
+					for (auto const& artifact: _outputSelection[file][contract])
+						artifacts.append(artifact);
 		}
 
-	return false;
+	return artifacts;
 }
 
-bool isArtifactRequested(Json::Value const& _outputSelection, string const& _file, string const& _contract, vector<string> const& _artifacts, bool _wildcardMatchesExperimental)
+bool isArtifactRequested(Json::Value const& _requests, vector<string> const& _artifacts, bool _wildcardMatchesExperimental)
 {
 	for (auto const& artifact: _artifacts)
-		if (isArtifactRequested(_outputSelection, _file, _contract, artifact, _wildcardMatchesExperimental))
+		if (isArtifactRequested(_requests, artifact, _wildcardMatchesExperimental))
 			return true;
 	return false;
 }
 
-/// @returns true if any binary was requested, i.e. we actually have to perform compilation.
-bool isBinaryRequested(Json::Value const& _outputSelection)
+/// @returns true if @a _artifact is requested for any contract in @a _outputSelection.
+bool isArtifactRequestedForAnyContract(Json::Value const& _outputSelection, string const& _artifact)
 {
 	if (!_outputSelection.isObject())
 		return false;
 
+	for (auto const& fileRequests: _outputSelection)
+		if (fileRequests.isObject())
+			for (auto const& requests: fileRequests)
+				if (requests.isArray() && isArtifactRequested(requests, _artifact, false))
+					return true;
+	return false;
+}
+
+/// @returns true if any of the artifacts in @a _requests needs code generation.
+bool requiresBinary(Json::Value const& _requests)
+{
 	// This does not inculde "evm.methodIdentifiers" on purpose!
 	static vector<string> const outputsThatRequireBinaries{
 		"*",
@@ -239,12 +248,27 @@ bool isBinaryRequested(Json::Value const& _outputSelection)
 		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
 	};
 
-	for (auto const& fileRequests: _outputSelection)
-		for (auto const& requests: fileRequests)
-			for (auto const& output: outputsThatRequireBinaries)
-				if (isArtifactRequested(requests, output, false))
-					return true;
-	return false;
+	return _requests.isArray() && isArtifactRequested(_requests, outputsThatRequireBinaries, false);
+}
+
+/// @returns the names of the contracts that need code generation, in the format
+/// of CompilerStack::setCompiledContractNames. Source unit level selections
+/// are ignored, since they never request code.
+map<string, set<string>> contractsRequiringBinaries(Json::Value const& _outputSelection)
+{
+	map<string, set<string>> contracts;
+	if (!_outputSelection.isObject())
+		return contracts;
+
+	for (auto const& sourceName: _outputSelection.getMemberNames())
+	{
+		if (!_outputSelection[sourceName].isObject())
+			continue;
+		for (auto const& contractName: _outputSelection[sourceName].getMemberNames())
+			if (!contractName.empty() && requiresBinary(_outputSelection[sourceName][contractName]))
+				contracts[sourceName == "*" ? "" : sourceName].insert(contractName == "*" ? "" : contractName);
+	}
+	return contracts;
 }
 
 /// @returns true if any Ewasm code was requested. Note that as an exception, '*' does not
@@ -319,6 +343,28 @@ Json::Value collectEVMObject(evmasm::LinkerObject const& _object, string const*
 	return output;
 }
 
+Json::Value formatAllocationCounters(util::AllocationCounters const& _counters)
+{
+	Json::Value output = Json::objectValue;
+	output["allocations"] = Json::Value(Json::UInt64(_counters.allocations));
+	output["allocatedBytes"] = Json::Value(Json::UInt64(_counters.allocatedBytes));
+	output["peakBytes"] = Json::Value(Json::UInt64(_counters.peakBytes));
+	return output;
+}
+
+Json::Value collectAllocationStatistics()
+{
+	Json::Value output = formatAllocationCounters(util::AllocationStatistics::total());
+	output["phases"] = Json::objectValue;
+	for (auto const& [phase, counters]: util::AllocationStatistics::phases())
+		output["phases"][phase] = formatAllocationCounters(counters);
+	output["contracts"] = Json::objectValue;
+	for (auto const& [contract, phases]: util::AllocationStatistics::contracts())
+		for (auto const& [phase, counters]: phases)
+			output["contracts"][contract][phase] = formatAllocationCounters(counters);
+	return output;
+}
+
 std::optional<Json::Value> checkKeys(Json::Value const& _input, set<string> const& _keys, string const& _name)
 {
 	if (!!_input && !_input.isObject())
@@ -363,7 +409,7 @@ std::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkOptimizerDetailsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"peephole", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails"};
+	static set<string> keys{"peephole", "jumpdestRemover", "orderLiterals", "deduplicate", "jumpThreader", "cse", "constantOptimizer", "yul", "yulDetails"};
 	return checkKeys(_input, keys, "settings.optimizer.details");
 }
 
@@ -475,6 +521,8 @@ boost::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Valu
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "deduplicate", settings.runDeduplicate))
 			return *error;
+		if (auto error = checkOptimizerDetail(details, "jumpThreader", settings.runJumpThreader))
+			return *error;
 		if (auto error = checkOptimizerDetail(details, "cse", settings.runCSE))
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "constantOptimizer", settings.runConstantOptimiser))
@@ -541,7 +589,7 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 					"Mismatch between content and supplied hash for \"" + sourceName + "\""
 				));
 			else
-				ret.sources[sourceName] = content;
+				ret.sources[sourceName] = std::move(content);
 		}
 		else if (sources[sourceName]["urls"].isArray())
 		{
@@ -556,6 +604,8 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 				if (!url.isString())
 					return formatFatalError("JSONError", "URL must be a string.");
 				ReadCallback::Result result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), url.asString());
+				if (result.success && result.file)
+					result.responseOrErrorMessage = string(result.file->contents());
 				if (result.success)
 				{
 					if (!hash.empty() && !hashMatchesContent(hash, result.responseOrErrorMessage))
@@ -567,7 +617,7 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 						));
 					else
 					{
-						ret.sources[sourceName] =  result.responseOrErrorMessage;
+						ret.sources[sourceName] = std::move(result.responseOrErrorMessage);
 						found = true;
 						break;
 					}
@@ -651,7 +701,7 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 
 	if (settings.isMember("debug"))
 	{
-		if (auto result = checkKeys(settings["debug"], {"revertStrings"}, "settings.debug"))
+		if (auto result = checkKeys(settings["debug"], {"revertStrings", "allocationStatistics"}, "settings.debug"))
 			return *result;
 
 		if (settings["debug"].isMember("revertStrings"))
@@ -668,6 +718,13 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 				);
 			ret.revertStrings = *revertStrings;
 		}
+
+		if (settings["debug"].isMember("allocationStatistics"))
+		{
+			if (!settings["debug"]["allocationStatistics"].isBool())
+				return formatFatalError("JSONError", "settings.debug.allocationStatistics must be a Boolean.");
+			ret.allocationStatistics = settings["debug"]["allocationStatistics"].asBool();
+		}
 	}
 
 	if (settings.isMember("remappings") && !settings["remappings"].isArray())
@@ -760,12 +817,16 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 	return { std::move(ret) };
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings, util::JsonCompactStreamWriter* _writer)
 {
 	CompilerStack compilerStack(m_readFile);
 
-	StringMap sourceList = std::move(_inputsAndSettings.sources);
-	compilerStack.setSources(sourceList);
+	// The sources are moved into the compiler stack. A copy is only kept if
+	// they are needed for the assembly output.
+	StringMap sourceList;
+	if (isArtifactRequestedForAnyContract(_inputsAndSettings.outputSelection, "evm.assembly"))
+		sourceList = _inputsAndSettings.sources;
+	compilerStack.setSources(std::move(_inputsAndSettings.sources));
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
@@ -777,6 +838,8 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
 	compilerStack.setMetadataHash(_inputsAndSettings.metadataHash);
 	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
+	map<string, set<string>> const compiledContractNames = contractsRequiringBinaries(_inputsAndSettings.outputSelection);
+	compilerStack.setCompiledContractNames(compiledContractNames);
 
 	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
 
@@ -784,7 +847,10 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
-	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
+	bool const binariesRequested = !compiledContractNames.empty();
+
+	if (_inputsAndSettings.allocationStatistics)
+		util::AllocationStatistics::enable();
 
 	try
 	{
@@ -895,6 +961,9 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		));
 	}
 
+	if (_inputsAndSettings.allocationStatistics)
+		util::AllocationStatistics::disable();
+
 	bool analysisPerformed = compilerStack.state() >= CompilerStack::State::AnalysisPerformed;
 	bool const compilationSuccess = compilerStack.state() == CompilerStack::State::CompilationSuccessful;
 
@@ -914,105 +983,188 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		for (string const& query: compilerStack.unhandledSMTLib2Queries())
 			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
 
+	if (_inputsAndSettings.allocationStatistics)
+	{
+		if (util::AllocationStatistics::available())
+			output["debug"]["allocationStatistics"] = collectAllocationStatistics();
+		else
+			output["errors"].append(formatError(
+				true,
+				"JSONError",
+				"general",
+				"Allocation statistics are not available in this build of the compiler."
+			));
+	}
+
 	bool const wildcardMatchesExperimental = false;
 
-	output["sources"] = Json::objectValue;
-	unsigned sourceIndex = 0;
-	for (string const& sourceName: analysisPerformed ? compilerStack.sourceNames() : vector<string>())
+	auto sourceResult = [&](string const& _sourceName, unsigned _sourceIndex)
 	{
+		Json::Value const artifacts = requestedArtifacts(_inputsAndSettings.outputSelection, _sourceName, "");
 		Json::Value sourceResult = Json::objectValue;
-		sourceResult["id"] = sourceIndex++;
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-			sourceResult["ast"] = ASTJsonConverter(false, compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "legacyAST", wildcardMatchesExperimental))
-			sourceResult["legacyAST"] = ASTJsonConverter(true, compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-		output["sources"][sourceName] = sourceResult;
-	}
+		sourceResult["id"] = _sourceIndex;
+		if (isArtifactRequested(artifacts, "ast", wildcardMatchesExperimental))
+			sourceResult["ast"] = ASTJsonConverter(false, compilerStack.sourceIndices()).toJson(compilerStack.ast(_sourceName));
+		if (isArtifactRequested(artifacts, "legacyAST", wildcardMatchesExperimental))
+			sourceResult["legacyAST"] = ASTJsonConverter(true, compilerStack.sourceIndices()).toJson(compilerStack.ast(_sourceName));
+		return sourceResult;
+	};
 
-	Json::Value contractsOutput = Json::objectValue;
-	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
+	// The output of a contract is empty if nothing was requested for it.
+	auto contractResult = [&](string const& _contractName, string const& _file, string const& _name)
 	{
-		size_t colon = contractName.rfind(':');
-		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
+		Json::Value contractData(Json::objectValue);
+		Json::Value const artifacts = requestedArtifacts(_inputsAndSettings.outputSelection, _file, _name);
+		if (artifacts.empty())
+			return contractData;
+		// Only contracts that need code are compiled, so their code artifacts are available.
+		bool const compiled = compilationSuccess && requiresBinary(artifacts);
 
 		// ABI, storage layout, documentation and metadata
-		Json::Value contractData(Json::objectValue);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
-			contractData["abi"] = compilerStack.contractABI(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
-			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
-			contractData["metadata"] = compilerStack.metadata(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
-			contractData["userdoc"] = compilerStack.natspecUser(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
-			contractData["devdoc"] = compilerStack.natspecDev(contractName);
+		if (isArtifactRequested(artifacts, "abi", wildcardMatchesExperimental))
+			contractData["abi"] = compilerStack.contractABI(_contractName);
+		if (isArtifactRequested(artifacts, "storageLayout", false))
+			contractData["storageLayout"] = compilerStack.storageLayout(_contractName);
+		if (isArtifactRequested(artifacts, "metadata", wildcardMatchesExperimental))
+			contractData["metadata"] = compilerStack.metadata(_contractName);
+		if (isArtifactRequested(artifacts, "userdoc", wildcardMatchesExperimental))
+			contractData["userdoc"] = compilerStack.natspecUser(_contractName);
+		if (isArtifactRequested(artifacts, "devdoc", wildcardMatchesExperimental))
+			contractData["devdoc"] = compilerStack.natspecDev(_contractName);
 
 		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
+		if (compiled && isArtifactRequested(artifacts, "ir", wildcardMatchesExperimental))
+			contractData["ir"] = compilerStack.yulIR(_contractName);
+		if (compiled && isArtifactRequested(artifacts, "irOptimized", wildcardMatchesExperimental))
+			contractData["irOptimized"] = compilerStack.yulIROptimized(_contractName);
 
 		// Ewasm
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
-			contractData["ewasm"]["wast"] = compilerStack.ewasm(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
-			contractData["ewasm"]["wasm"] = compilerStack.ewasmObject(contractName).toHex();
+		if (compiled && isArtifactRequested(artifacts, "ewasm.wast", wildcardMatchesExperimental))
+			contractData["ewasm"]["wast"] = compilerStack.ewasm(_contractName);
+		if (compiled && isArtifactRequested(artifacts, "ewasm.wasm", wildcardMatchesExperimental))
+			contractData["ewasm"]["wasm"] = compilerStack.ewasmObject(_contractName).toHex();
 
 		// EVM
 		Json::Value evmData(Json::objectValue);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
-
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
+		if (compiled && isArtifactRequested(artifacts, "evm.assembly", wildcardMatchesExperimental))
+			evmData["assembly"] = compilerStack.assemblyString(_contractName, sourceList);
+		if (compiled && isArtifactRequested(artifacts, "evm.legacyAssembly", wildcardMatchesExperimental))
+			evmData["legacyAssembly"] = compilerStack.assemblyJSON(_contractName);
+		if (isArtifactRequested(artifacts, "evm.methodIdentifiers", wildcardMatchesExperimental))
+			evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(_contractName);
+		if (compiled && isArtifactRequested(artifacts, "evm.gasEstimates", wildcardMatchesExperimental))
+			evmData["gasEstimates"] = compilerStack.gasEstimates(_contractName);
+
+		if (compiled && isArtifactRequested(
+			artifacts,
 			{ "evm.bytecode", "evm.bytecode.object", "evm.bytecode.opcodes", "evm.bytecode.sourceMap", "evm.bytecode.linkReferences" },
 			wildcardMatchesExperimental
 		))
 			evmData["bytecode"] = collectEVMObject(
-				compilerStack.object(contractName),
-				compilerStack.sourceMapping(contractName)
+				compilerStack.object(_contractName),
+				compilerStack.sourceMapping(_contractName)
 			);
 
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
+		if (compiled && isArtifactRequested(
+			artifacts,
 			{ "evm.deployedBytecode", "evm.deployedBytecode.object", "evm.deployedBytecode.opcodes", "evm.deployedBytecode.sourceMap", "evm.deployedBytecode.linkReferences" },
 			wildcardMatchesExperimental
 		))
 			evmData["deployedBytecode"] = collectEVMObject(
-				compilerStack.runtimeObject(contractName),
-				compilerStack.runtimeSourceMapping(contractName)
+				compilerStack.runtimeObject(_contractName),
+				compilerStack.runtimeSourceMapping(_contractName)
 			);
 
 		if (!evmData.empty())
 			contractData["evm"] = evmData;
 
-		if (!contractData.empty())
+		return contractData;
+	};
+
+	// Contracts grouped by source, in the order of the output.
+	map<string, map<string, string>> contractsBySource;
+	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
+	{
+		size_t colon = contractName.rfind(':');
+		solAssert(colon != string::npos, "");
+		contractsBySource[contractName.substr(0, colon)][contractName.substr(colon + 1)] = contractName;
+	}
+	vector<string> const sourceNames = analysisPerformed ? compilerStack.sourceNames() : vector<string>();
+
+	if (!_writer)
+	{
+		output["sources"] = Json::objectValue;
+		unsigned sourceIndex = 0;
+		for (string const& sourceName: sourceNames)
+			output["sources"][sourceName] = sourceResult(sourceName, sourceIndex++);
+
+		for (auto const& [file, contracts]: contractsBySource)
+			for (auto const& [name, contractName]: contracts)
+			{
+				Json::Value contractData = contractResult(contractName, file, name);
+				if (!contractData.empty())
+					output["contracts"][file][name] = std::move(contractData);
+			}
+
+		return output;
+	}
+
+	// Write the members in the order of their keys, so that the output is the same as above.
+	// Every source and contract is released as soon as it has been written.
+	vector<string> const members = output.getMemberNames();
+	size_t nextMember = 0;
+	auto writeMembersBefore = [&](string const& _key)
+	{
+		for (; nextMember < members.size() && members[nextMember] < _key; ++nextMember)
 		{
-			if (!contractsOutput.isMember(file))
-				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			_writer->member(members[nextMember], output[members[nextMember]]);
+			output.removeMember(members[nextMember]);
 		}
+	};
+
+	bool contractsStarted = false;
+	for (auto const& [file, contracts]: contractsBySource)
+	{
+		bool sourceStarted = false;
+		for (auto const& [name, contractName]: contracts)
+		{
+			Json::Value const contractData = contractResult(contractName, file, name);
+			if (contractData.empty())
+				continue;
+			if (!contractsStarted)
+			{
+				writeMembersBefore("contracts");
+				_writer->beginObject("contracts");
+				contractsStarted = true;
+			}
+			if (!sourceStarted)
+			{
+				_writer->beginObject(file);
+				sourceStarted = true;
+			}
+			_writer->member(name, contractData);
+		}
+		if (sourceStarted)
+			_writer->endObject();
 	}
-	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
+	if (contractsStarted)
+		_writer->endObject();
 
-	return output;
-}
+	// The sources are written after the errors. If writing them fails, the output is left
+	// incomplete, so that the failure cannot be mistaken for a successful compilation.
+	writeMembersBefore("sources");
+	_writer->beginObject("sources");
+	unsigned sourceIndex = 0;
+	for (string const& sourceName: sourceNames)
+		_writer->member(sourceName, sourceResult(sourceName, sourceIndex++));
+	_writer->endObject();
+
+	for (; nextMember < members.size(); ++nextMember)
+		_writer->member(members[nextMember], output[members[nextMember]]);
+	_writer->finish();
 
+	return Json::nullValue;
+}
 
 Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 {
@@ -1026,6 +1178,8 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		return formatFatalError("JSONError", "Field \"settings.libraries\" cannot be used for Yul.");
 	if (_inputsAndSettings.revertStrings != RevertStrings::Default)
 		return formatFatalError("JSONError", "Field \"settings.debug.revertStrings\" cannot be used for Yul.");
+	if (_inputsAndSettings.allocationStatistics)
+		return formatFatalError("JSONError", "Field \"settings.debug.allocationStatistics\" cannot be used for Yul.");
 
 	Json::Value output = Json::objectValue;
 
@@ -1065,9 +1219,10 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 	output["errors"].append(formatError(true, "Warning", "general", "Yul is still experimental. Please use the output with care."));
 
 	string contractName = stack.parserResult()->name.str();
+	Json::Value const artifacts = requestedArtifacts(_inputsAndSettings.outputSelection, sourceName, contractName);
 
 	bool const wildcardMatchesExperimental = true;
-	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "ir", wildcardMatchesExperimental))
+	if (isArtifactRequested(artifacts, "ir", wildcardMatchesExperimental))
 		output["contracts"][sourceName][contractName]["ir"] = stack.print();
 
 	stack.optimize();
@@ -1075,17 +1230,15 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 	MachineAssemblyObject object = stack.assemble(AssemblyStack::Machine::EVM);
 
 	if (isArtifactRequested(
-		_inputsAndSettings.outputSelection,
-		sourceName,
-		contractName,
+		artifacts,
 		{ "evm.bytecode", "evm.bytecode.object", "evm.bytecode.opcodes", "evm.bytecode.sourceMap", "evm.bytecode.linkReferences" },
 		wildcardMatchesExperimental
 	))
 		output["contracts"][sourceName][contractName]["evm"]["bytecode"] = collectEVMObject(*object.bytecode, object.sourceMappings.get());
 
-	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "irOptimized", wildcardMatchesExperimental))
+	if (isArtifactRequested(artifacts, "irOptimized", wildcardMatchesExperimental))
 		output["contracts"][sourceName][contractName]["irOptimized"] = stack.print();
-	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "evm.assembly", wildcardMatchesExperimental))
+	if (isArtifactRequested(artifacts, "evm.assembly", wildcardMatchesExperimental))
 		output["contracts"][sourceName][contractName]["evm"]["assembly"] = object.assembly;
 
 	return output;
@@ -1093,6 +1246,11 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
+{
+	return compile(_input, nullptr);
+}
+
+Json::Value StandardCompiler::compile(Json::Value const& _input, util::JsonCompactStreamWriter* _writer) noexcept
 {
 	YulStringRepository::reset();
 
@@ -1103,7 +1261,7 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 			return boost::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = boost::get<InputsAndSettings>(std::move(parsed));
 		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+			return compileSolidity(std::move(settings), _writer);
 		else if (settings.language == "Yul")
 			return compileYul(std::move(settings));
 		else
@@ -1128,29 +1286,55 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 }
 
 string StandardCompiler::compile(string const& _input) noexcept
+{
+	ostringstream output;
+	compile(_input, output);
+	return output.str();
+}
+
+void StandardCompiler::compile(string const& _input, ostream& _output) noexcept
 {
 	Json::Value input;
 	string errors;
 	try
 	{
 		if (!util::jsonParseStrict(_input, input, &errors))
-			return util::jsonCompactPrint(formatFatalError("JSONError", errors));
+		{
+			_output << util::jsonCompactPrint(formatFatalError("JSONError", errors));
+			return;
+		}
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		return;
 	}
 
+	util::JsonCompactStreamWriter writer(_output);
 	// cout << "Input: " << input.toStyledString() << endl;
-	Json::Value output = compile(input);
-	// cout << "Output: " << output.toStyledString() << endl;
+	Json::Value output = compile(input, &writer);
 
 	try
 	{
-		return util::jsonCompactPrint(output);
+		if (writer.empty())
+			_output << util::jsonCompactPrint(output);
+		else if (writer.depth() > 0)
+		{
+			// The output was interrupted by an error. If the errors have not been written yet,
+			// close the open objects, so that the output stays valid JSON, and report the error.
+			// Otherwise, the output is left incomplete, so that the error cannot go unnoticed.
+			while (writer.depth() > 1)
+				writer.endObject();
+			if (!writer.lastKey() || *writer.lastKey() < "errors")
+			{
+				writer.member("errors", output["errors"]);
+				writer.finish();
+			}
+		}
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+		if (writer.empty())
+			_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
 	}
 }
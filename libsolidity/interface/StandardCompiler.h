@@ -23,8 +23,10 @@
 #pragma once
 
 #include <libsolidity/interface/CompilerStack.h>
+#include <libsolutil/JSON.h>
 
 #include <optional>
+#include <ostream>
 #include <boost/variant.hpp>
 
 namespace solidity::frontend
@@ -51,6 +53,10 @@ public:
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Same as above, but writes the output to @a _output while it is produced. The output of
+	/// each source and contract is released as soon as it has been written, which bounds the
+	/// memory needed for large outputs. The output is the same as that of the function above.
+	void compile(std::string const& _input, std::ostream& _output) noexcept;
 
 private:
 	struct InputsAndSettings
@@ -63,6 +69,7 @@ private:
 		langutil::EVMVersion evmVersion;
 		std::vector<CompilerStack::Remapping> remappings;
 		RevertStrings revertStrings = RevertStrings::Default;
+		bool allocationStatistics = false;
 		OptimiserSettings optimiserSettings = OptimiserSettings::minimal();
 		std::map<std::string, util::h160> libraries;
 		bool metadataLiteralSources = false;
@@ -74,7 +81,11 @@ private:
 	/// it in condensed form or an error as a json object.
 	boost::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Performs compilation and processing as compile() above. If @a _writer is given, the output
+	/// of a successful compilation is written to it and a null value is returned.
+	Json::Value compile(Json::Value const& _input, util::JsonCompactStreamWriter* _writer) noexcept;
+
+	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings, util::JsonCompactStreamWriter* _writer = nullptr);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
@@ -0,0 +1,169 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Accounting of heap allocations per compiler phase.
+ */
+
+#include <libsolutil/AllocationStatistics.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+namespace
+{
+
+struct ActivePhase
+{
+	AllocationCounters* counters;
+	/// Counters of the phase for the current contract, if any.
+	AllocationCounters* contractCounters;
+	string contract;
+};
+
+struct State
+{
+	/// The thread whose allocations are attributed to phases.
+	thread::id owner;
+	AllocationCounters total;
+	map<string, AllocationCounters> phases;
+	map<string, map<string, AllocationCounters>> contracts;
+	vector<ActivePhase> activePhases;
+};
+
+// Everything accessed by recordAllocation is constant-initialized, since allocations
+// can happen before dynamic initialization.
+atomic<bool> s_available{false};
+atomic<bool> s_enabled{false};
+State* s_state = nullptr;
+// Bytes allocated minus bytes freed by the current thread. It is kept per thread,
+// so that allocations do not need atomic operations.
+thread_local int64_t t_liveBytes = 0;
+
+/// @returns the live bytes of the current thread. These can be negative if the thread
+/// freed memory allocated by other threads.
+uint64_t currentLiveBytes() noexcept
+{
+	return static_cast<uint64_t>(max<int64_t>(t_liveBytes, 0));
+}
+
+void count(AllocationCounters& _counters, size_t _size, uint64_t _liveBytes)
+{
+	_counters.allocations++;
+	_counters.allocatedBytes += _size;
+	_counters.peakBytes = max(_counters.peakBytes, _liveBytes);
+}
+
+}
+
+void AllocationStatistics::recordAllocation(size_t _size) noexcept
+{
+	// Only written once, so that the flag is not modified by every thread on every allocation.
+	if (!s_available.load(memory_order_relaxed))
+		s_available.store(true, memory_order_relaxed);
+	t_liveBytes += static_cast<int64_t>(_size);
+	if (!s_enabled.load(memory_order_relaxed) || s_state->owner != this_thread::get_id())
+		return;
+
+	uint64_t const liveBytes = currentLiveBytes();
+
+	count(s_state->total, _size, liveBytes);
+	for (ActivePhase const& phase: s_state->activePhases)
+	{
+		count(*phase.counters, _size, liveBytes);
+		if (phase.contractCounters)
+			count(*phase.contractCounters, _size, liveBytes);
+	}
+}
+
+void AllocationStatistics::recordDeallocation(size_t _size) noexcept
+{
+	t_liveBytes -= static_cast<int64_t>(_size);
+}
+
+bool AllocationStatistics::available() noexcept
+{
+	return s_available.load(memory_order_relaxed);
+}
+
+void AllocationStatistics::enable()
+{
+	disable();
+	delete s_state;
+	s_state = new State{};
+	s_state->owner = this_thread::get_id();
+	s_state->total.peakBytes = currentLiveBytes();
+	s_enabled.store(true, memory_order_relaxed);
+}
+
+void AllocationStatistics::disable() noexcept
+{
+	s_enabled.store(false, memory_order_relaxed);
+}
+
+bool AllocationStatistics::enabled() noexcept
+{
+	return s_enabled.load(memory_order_relaxed);
+}
+
+AllocationCounters AllocationStatistics::total()
+{
+	return s_state ? s_state->total : AllocationCounters{};
+}
+
+map<string, AllocationCounters> AllocationStatistics::phases()
+{
+	return s_state ? s_state->phases : map<string, AllocationCounters>{};
+}
+
+map<string, map<string, AllocationCounters>> AllocationStatistics::contracts()
+{
+	return s_state ? s_state->contracts : map<string, map<string, AllocationCounters>>{};
+}
+
+ScopedAllocationPhase::ScopedAllocationPhase(string const& _phase, string const& _contract)
+{
+	if (!AllocationStatistics::enabled() || s_state->owner != this_thread::get_id())
+		return;
+
+	// Creating the entries allocates, so the new phase is activated only afterwards.
+	string contract = _contract;
+	if (contract.empty() && !s_state->activePhases.empty())
+		contract = s_state->activePhases.back().contract;
+	ActivePhase phase{&s_state->phases[_phase], nullptr, contract};
+	if (!contract.empty())
+		phase.contractCounters = &s_state->contracts[contract][_phase];
+
+	uint64_t const liveBytes = currentLiveBytes();
+	phase.counters->peakBytes = max(phase.counters->peakBytes, liveBytes);
+	if (phase.contractCounters)
+		phase.contractCounters->peakBytes = max(phase.contractCounters->peakBytes, liveBytes);
+
+	s_state->activePhases.emplace_back(move(phase));
+	m_active = true;
+}
+
+ScopedAllocationPhase::~ScopedAllocationPhase()
+{
+	if (m_active && s_state && !s_state->activePhases.empty())
+		s_state->activePhases.pop_back();
+}
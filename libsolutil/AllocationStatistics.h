@@ -0,0 +1,98 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Accounting of heap allocations per compiler phase.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace solidity::util
+{
+
+struct AllocationCounters
+{
+	/// Number of allocations.
+	uint64_t allocations = 0;
+	/// Sum of the sizes of all allocations.
+	uint64_t allocatedBytes = 0;
+	/// Largest number of bytes that were allocated at the same time by the thread that
+	/// enabled the statistics.
+	uint64_t peakBytes = 0;
+};
+
+/**
+ * Collects statistics about heap allocations while enabled, grouped by the phases
+ * that are active (see ScopedAllocationPhase).
+ *
+ * Allocations are only seen if the executable replaces the global allocation functions
+ * and reports to recordAllocation and recordDeallocation, which solc does unless it is
+ * built with -DSOLC_ALLOCATION_STATISTICS=OFF.
+ * Phases can be nested, the numbers of a phase include those of its nested phases.
+ * Only allocations of the thread that enabled the statistics are attributed to phases.
+ */
+class AllocationStatistics
+{
+public:
+	/// Reports an allocation of @a _size bytes. Must not allocate itself.
+	static void recordAllocation(size_t _size) noexcept;
+	/// Reports the deallocation of a block of @a _size bytes. Must not allocate itself.
+	static void recordDeallocation(size_t _size) noexcept;
+
+	/// @returns true if allocations are reported in this executable.
+	static bool available() noexcept;
+
+	/// Discards previous results and starts collecting statistics.
+	/// Must not be called while a phase is active.
+	static void enable();
+	/// Stops collecting statistics. The results stay accessible.
+	static void disable() noexcept;
+	static bool enabled() noexcept;
+
+	/// @returns the counters for all allocations since the statistics were enabled.
+	static AllocationCounters total();
+	/// @returns the counters by name of the phase.
+	static std::map<std::string, AllocationCounters> phases();
+	/// @returns the counters by contract and name of the phase, for phases that were
+	/// associated with a contract.
+	static std::map<std::string, std::map<std::string, AllocationCounters>> contracts();
+};
+
+/**
+ * Attributes allocations to a phase for the lifetime of the object.
+ * Does nothing unless AllocationStatistics are enabled.
+ */
+class ScopedAllocationPhase
+{
+public:
+	/// @param _contract the contract the phase is about. Defaults to the contract
+	/// of the enclosing phase.
+	explicit ScopedAllocationPhase(std::string const& _phase, std::string const& _contract = {});
+	~ScopedAllocationPhase();
+
+	ScopedAllocationPhase(ScopedAllocationPhase const&) = delete;
+	ScopedAllocationPhase& operator=(ScopedAllocationPhase const&) = delete;
+
+private:
+	bool m_active = false;
+};
+
+}
@@ -173,6 +173,14 @@ std::map<V, K> invertMap(std::map<K, V> const& originalMap)
 	return inverseMap;
 }
 
+/// @returns a pointer to the entry of @a _map at @a _key, if there is one, and nullptr otherwise.
+template <typename MapType, typename KeyType>
+decltype(auto) valueOrNullptr(MapType&& _map, KeyType const& _key)
+{
+	auto it = _map.find(_key);
+	return (it == _map.end()) ? nullptr : &it->second;
+}
+
 // String conversion functions, mainly to/from hex/nibble/byte representations.
 
 enum class WhenError
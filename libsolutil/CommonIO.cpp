@@ -24,6 +24,7 @@
 
 #include <boost/filesystem.hpp>
 
+#include <array>
 #include <iostream>
 #include <cstdlib>
 #include <fstream>
@@ -70,15 +71,13 @@ string solidity::util::readFileAsString(string const& _file)
 
 string solidity::util::readStandardInput()
 {
+	// Read in large blocks instead of line by line. The trailing newline is kept
+	// for compatibility with the previous line based reading.
 	string ret;
-	while (!cin.eof())
-	{
-		string tmp;
-		// NOTE: this will read until EOF or NL
-		getline(cin, tmp);
-		ret.append(tmp);
-		ret.append("\n");
-	}
+	array<char, 65536> buffer;
+	while (cin.read(buffer.data(), buffer.size()) || cin.gcount() > 0)
+		ret.append(buffer.data(), static_cast<size_t>(cin.gcount()));
+	ret.push_back('\n');
 	return ret;
 }
 
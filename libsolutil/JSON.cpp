@@ -60,6 +60,8 @@ public:
 	StrictModeCharReaderBuilder()
 	{
 		Json::CharReaderBuilder::strictMode(&this->settings_);
+		// Comments are never used, so do not spend time on attaching them to the values.
+		this->settings_["collectComments"] = false;
 	}
 };
 
@@ -105,6 +107,63 @@ string jsonCompactPrint(Json::Value const& _input)
 	return print(_input, writerBuilder);
 }
 
+void JsonCompactStreamWriter::member(string const& _key, Json::Value const& _value)
+{
+	static map<string, Json::Value> settings{{"indentation", ""}};
+	static StreamWriterBuilder writerBuilder(settings);
+	writeKey(_key);
+	unique_ptr<Json::StreamWriter> writer(writerBuilder.newStreamWriter());
+	writer->write(_value, &m_out);
+}
+
+void JsonCompactStreamWriter::beginObject(string const& _key)
+{
+	writeKey(_key);
+	m_out << '{';
+	m_lastKeys.emplace_back();
+}
+
+void JsonCompactStreamWriter::endObject()
+{
+	if (m_lastKeys.empty())
+		return;
+	m_out << '}';
+	m_lastKeys.pop_back();
+}
+
+void JsonCompactStreamWriter::finish()
+{
+	if (!m_started)
+	{
+		m_out << '{';
+		m_started = true;
+		m_lastKeys.emplace_back();
+	}
+	while (!m_lastKeys.empty())
+		endObject();
+}
+
+optional<string> JsonCompactStreamWriter::lastKey() const
+{
+	if (m_lastKeys.empty())
+		return nullopt;
+	return m_lastKeys.back();
+}
+
+void JsonCompactStreamWriter::writeKey(string const& _key)
+{
+	if (!m_started)
+	{
+		m_out << '{';
+		m_started = true;
+		m_lastKeys.emplace_back();
+	}
+	if (m_lastKeys.back())
+		m_out << ',';
+	m_lastKeys.back() = _key;
+	m_out << jsonCompactPrint(Json::Value(_key)) << ':';
+}
+
 bool jsonParseStrict(string const& _input, Json::Value& _json, string* _errs /* = nullptr */)
 {
 	static StrictModeCharReaderBuilder readerBuilder;
@@ -24,7 +24,10 @@
 
 #include <json/json.h>
 
+#include <optional>
+#include <ostream>
 #include <string>
+#include <vector>
 
 namespace solidity::util {
 
@@ -34,6 +37,39 @@ std::string jsonPrettyPrint(Json::Value const& _input);
 /// Serialise the JSON object (@a _input) without indentation
 std::string jsonCompactPrint(Json::Value const& _input);
 
+/// Writes a JSON object to a stream member by member, so that large documents do not have
+/// to be kept in memory. The result is the same as that of jsonCompactPrint if the members
+/// of each object are written in the order of their keys.
+class JsonCompactStreamWriter
+{
+public:
+	explicit JsonCompactStreamWriter(std::ostream& _out): m_out(_out) {}
+
+	/// Writes the member @a _key with value @a _value to the innermost open object.
+	void member(std::string const& _key, Json::Value const& _value);
+	/// Opens an object as member @a _key of the innermost open object.
+	void beginObject(std::string const& _key);
+	/// Closes the innermost open object.
+	void endObject();
+	/// Closes all open objects, including the top level object.
+	void finish();
+
+	/// @returns true if nothing has been written yet.
+	bool empty() const { return !m_started; }
+	/// @returns the number of open objects, including the top level object.
+	size_t depth() const { return m_lastKeys.size(); }
+	/// @returns the key of the member last written to the innermost open object, if any.
+	std::optional<std::string> lastKey() const;
+
+private:
+	void writeKey(std::string const& _key);
+
+	std::ostream& m_out;
+	bool m_started = false;
+	/// For each open object, the key of the member last written to it.
+	std::vector<std::optional<std::string>> m_lastKeys;
+};
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
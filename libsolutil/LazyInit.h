@@ -0,0 +1,57 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <mutex>
+#include <optional>
+
+namespace solidity::util
+{
+
+/// Value that is computed on first access and cached afterwards.
+/// The computation is synchronised, so the value is computed at most once even if it is
+/// accessed concurrently. If the computation throws, the value stays uncomputed and the
+/// next access tries again.
+///
+/// Json::Value const& abi() const
+/// {
+///		return m_abi.init([&]{ return ABI::generate(m_contract); });
+/// }
+///
+/// The value is not copied or moved, so objects containing it have to be constructed in place.
+template <class T>
+class LazyInit
+{
+public:
+	LazyInit() = default;
+	LazyInit(LazyInit const&) = delete;
+	LazyInit& operator=(LazyInit const&) = delete;
+
+	/// @returns the value, computing it using @a _compute if this is the first access.
+	template <class F>
+	T const& init(F&& _compute) const
+	{
+		std::call_once(m_computed, [&]() { m_value.emplace(_compute()); });
+		return *m_value;
+	}
+
+private:
+	mutable std::once_flag m_computed;
+	mutable std::optional<T> m_value;
+};
+
+}
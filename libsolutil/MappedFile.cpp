@@ -0,0 +1,86 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Read-only view on the contents of a file that is mapped into memory.
+ */
+
+#include <libsolutil/MappedFile.h>
+
+#include <libsolutil/CommonIO.h>
+
+#include <boost/filesystem.hpp>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace solidity::util;
+
+shared_ptr<MappedFile const> MappedFile::open(string const& _path)
+{
+	shared_ptr<MappedFile> file{new MappedFile()};
+#if !defined(_WIN32)
+	int fd = ::open(_path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return nullptr;
+	struct stat status;
+	if (fstat(fd, &status) != 0 || !S_ISREG(status.st_mode))
+	{
+		::close(fd);
+		return nullptr;
+	}
+	// Empty files cannot be mapped.
+	if (status.st_size > 0)
+	{
+		void* mapping = mmap(nullptr, size_t(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping != MAP_FAILED)
+		{
+			file->m_mapping = mapping;
+			file->m_mappingSize = size_t(status.st_size);
+			file->m_contents = string_view(static_cast<char const*>(mapping), file->m_mappingSize);
+		}
+	}
+	::close(fd);
+	if (file->m_mapping || status.st_size == 0)
+		return file;
+#endif
+	if (!boost::filesystem::is_regular_file(_path))
+		return nullptr;
+	file->m_buffer = readFileAsString(_path);
+	file->m_contents = file->m_buffer;
+	return file;
+}
+
+shared_ptr<MappedFile const> MappedFile::fromContents(string _contents)
+{
+	shared_ptr<MappedFile> file{new MappedFile()};
+	file->m_buffer = std::move(_contents);
+	file->m_contents = file->m_buffer;
+	return file;
+}
+
+MappedFile::~MappedFile()
+{
+#if !defined(_WIN32)
+	if (m_mapping)
+		munmap(m_mapping, m_mappingSize);
+#endif
+}
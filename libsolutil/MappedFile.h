@@ -0,0 +1,63 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Read-only view on the contents of a file that is mapped into memory.
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace solidity::util
+{
+
+/**
+ * Immutable contents of a file. Where supported, the file is mapped into memory instead of
+ * being read, so that its pages are only loaded when they are accessed and can be shared
+ * with the page cache. Otherwise, the contents are read into memory.
+ * The contents stay valid as long as the object exists, which is usually shared by everything
+ * that references the contents. Mapped files must not be modified while they are in use.
+ */
+class MappedFile: boost::noncopyable
+{
+public:
+	/// @returns the contents of the file @a _path or nullptr if it cannot be read.
+	static std::shared_ptr<MappedFile const> open(std::string const& _path);
+	/// @returns an object that owns @a _contents, for contents that were obtained in a different way.
+	static std::shared_ptr<MappedFile const> fromContents(std::string _contents);
+
+	~MappedFile();
+
+	std::string_view contents() const noexcept { return m_contents; }
+
+private:
+	MappedFile() = default;
+
+	/// Start and size of the mapping, if the file is mapped.
+	void* m_mapping = nullptr;
+	size_t m_mappingSize = 0;
+	/// The contents if the file could not be mapped.
+	std::string m_buffer;
+	/// Refers to the buffer unless the file is mapped, so that it is never null.
+	std::string_view m_contents{m_buffer};
+};
+
+}
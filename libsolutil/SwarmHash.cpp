@@ -115,3 +115,10 @@ h256 solidity::util::bzzr1Hash(bytes const& _input)
 		return h256{};
 	return chunkHash(&_input);
 }
+
+h256 solidity::util::bzzr1Hash(string_view _input)
+{
+	if (_input.empty())
+		return h256{};
+	return chunkHash(bytesConstRef(reinterpret_cast<uint8_t const*>(_input.data()), _input.size()));
+}
@@ -22,6 +22,7 @@
 #include <libsolutil/FixedHash.h>
 
 #include <string>
+#include <string_view>
 
 namespace solidity::util
 {
@@ -32,9 +33,7 @@ h256 bzzr0Hash(std::string const& _input);
 /// Compute the "bzz hash" of @a _input (the NEW binary / BMT version)
 h256 bzzr1Hash(bytes const& _input);
 
-inline h256 bzzr1Hash(std::string const& _input)
-{
-	return bzzr1Hash(asBytes(_input));
-}
+/// Compute the "bzz hash" of @a _input without copying it.
+h256 bzzr1Hash(std::string_view _input);
 
 }
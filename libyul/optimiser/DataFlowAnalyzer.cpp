@@ -325,10 +325,66 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 {
 	SideEffectsCollector sideEffects(m_dialect, _expr, &m_functionSideEffects);
+
+	// For calls to user-defined functions whose arguments are variables or literals,
+	// we only clear the locations the function may write to.
+	FunctionCall const* call = get_if<FunctionCall>(&_expr);
+	FunctionWrites const* writes = nullptr;
+	if (call && all_of(call->arguments.begin(), call->arguments.end(), [](Expression const& _argument) {
+		return holds_alternative<Identifier>(_argument) || holds_alternative<Literal>(_argument);
+	}))
+		if (auto it = m_functionWrites.find(call->functionName.name); it != m_functionWrites.end())
+			writes = &it->second;
+
 	if (sideEffects.invalidatesStorage())
-		m_storage.clear();
+	{
+		if (writes)
+			clearWrittenLocations(m_storage, writes->storage, call->arguments, false);
+		else
+			m_storage.clear();
+	}
 	if (sideEffects.invalidatesMemory())
-		m_memory.clear();
+	{
+		if (writes)
+			clearWrittenLocations(m_memory, writes->memory, call->arguments, true);
+		else
+			m_memory.clear();
+	}
+}
+
+void DataFlowAnalyzer::clearWrittenLocations(
+	InvertibleMap<YulString, YulString>& _data,
+	WrittenLocations const& _locations,
+	vector<Expression> const& _arguments,
+	bool _isMemory
+)
+{
+	if (_locations.unknown)
+	{
+		_data.clear();
+		return;
+	}
+
+	vector<Expression> locations;
+	for (u256 const& value: _locations.literals)
+		locations.emplace_back(Literal{{}, LiteralKind::Number, YulString{formatNumber(value)}, {}});
+	for (size_t parameter: _locations.parameters)
+		locations.emplace_back(_arguments.at(parameter));
+
+	set<YulString> keysToErase;
+	for (auto const& item: _data.values)
+		for (Expression const& location: locations)
+			if (!(
+				_isMemory ?
+				m_knowledgeBase.knownToBeDifferentByAtLeast32(item.first, location) :
+				m_knowledgeBase.knownToBeDifferent(item.first, location)
+			))
+			{
+				keysToErase.insert(item.first);
+				break;
+			}
+	for (YulString const& key: keysToErase)
+		_data.eraseKey(key);
 }
 
 void DataFlowAnalyzer::joinKnowledge(
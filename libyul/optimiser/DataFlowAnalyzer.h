@@ -24,6 +24,7 @@
 
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/KnowledgeBase.h>
+#include <libyul/optimiser/Semantics.h>
 #include <libyul/YulString.h>
 #include <libyul/AsmData.h>
 #include <libyul/SideEffects.h>
@@ -65,6 +66,9 @@ struct AssignedValue
  *   where we cannot prove x != t or y == m_storage[t] using the current values of the variables x and t.
  * Otherwise, determine if the statement invalidates storage/memory. If yes, clear all knowledge
  * about storage/memory before visiting the statement. Then visit the statement.
+ * If the statement is a call to a user-defined function whose written locations are known,
+ * only the knowledge about slots t where we cannot prove that t differs from these locations
+ * is cleared.
  *
  * For forward-joining control flow, storage/memory information from the branches is combined.
  * If the keys or values are different or non-existent in one branch, the key is deleted.
@@ -85,12 +89,18 @@ public:
 	///            Side-effects of user-defined functions. Worst-case side-effects are assumed
 	///            if this is not provided or the function is not found.
 	///            The parameter is mostly used to determine movability of expressions.
+	/// @param _functionWrites
+	///            Storage and memory locations user-defined functions may write to.
+	///            All knowledge about storage and memory is cleared at calls to functions
+	///            that are not found.
 	explicit DataFlowAnalyzer(
 		Dialect const& _dialect,
-		std::map<YulString, SideEffects> _functionSideEffects = {}
+		std::map<YulString, SideEffects> _functionSideEffects = {},
+		std::map<YulString, FunctionWrites> _functionWrites = {}
 	):
 		m_dialect(_dialect),
 		m_functionSideEffects(std::move(_functionSideEffects)),
+		m_functionWrites(std::move(_functionWrites)),
 		m_knowledgeBase(_dialect, m_value)
 	{}
 
@@ -126,6 +136,15 @@ protected:
 	/// Clears knowledge about storage or memory if they may be modified inside the expression.
 	void clearKnowledgeIfInvalidated(Expression const& _expression);
 
+	/// Clears the knowledge about all keys in @a _data that may be overwritten by a call
+	/// with arguments @a _arguments to a function writing to @a _locations.
+	void clearWrittenLocations(
+		InvertibleMap<YulString, YulString>& _data,
+		WrittenLocations const& _locations,
+		std::vector<Expression> const& _arguments,
+		bool _isMemory
+	);
+
 	/// Joins knowledge about storage and memory with an older point in the control-flow.
 	/// This only works if the current state is a direct successor of the older point,
 	/// i.e. `_otherStorage` and `_otherMemory` cannot have additional changes.
@@ -151,6 +170,8 @@ protected:
 	/// Side-effects of user-defined functions. Worst-case side-effects are assumed
 	/// if this is not provided or the function is not found.
 	std::map<YulString, SideEffects> m_functionSideEffects;
+	/// Locations user-defined functions may write to.
+	std::map<YulString, FunctionWrites> m_functionWrites;
 
 	/// Current values of variables, always movable.
 	std::map<YulString, AssignedValue> m_value;
@@ -0,0 +1,148 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that removes ``sstore`` and ``mstore`` statements whose
+ * value can never be read.
+ */
+
+#include <libyul/optimiser/DeadStoreEliminator.h>
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmData.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/Visitor.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+using namespace solidity::yul;
+
+void DeadStoreEliminator::run(OptimiserStepContext& _context, Block& _ast)
+{
+	auto const* dialect = dynamic_cast<EVMDialect const*>(&_context.dialect);
+	if (!dialect)
+		return;
+
+	Assignments assignments;
+	assignments(_ast);
+	DeadStoreEliminator{
+		*dialect,
+		SideEffectsPropagator::sideEffects(*dialect, CallGraphGenerator::callGraph(_ast)),
+		assignments.names(),
+		!MSizeFinder::containsMSize(*dialect, _ast)
+	}(_ast);
+}
+
+void DeadStoreEliminator::operator()(Block& _block)
+{
+	ASTModifier::operator()(_block);
+
+	// Statement indices of the stores that were not read since, by instruction and location.
+	map<pair<Instruction, Location>, size_t> pendingStores;
+	set<size_t> deadStores;
+	auto removePending = [&](Instruction _instruction) {
+		for (auto it = pendingStores.begin(); it != pendingStores.end();)
+			if (it->first.first == _instruction)
+			{
+				deadStores.insert(it->second);
+				it = pendingStores.erase(it);
+			}
+			else
+				++it;
+	};
+
+	for (size_t index = 0; index < _block.statements.size(); ++index)
+	{
+		Statement const& statement = _block.statements[index];
+		BuiltinFunctionForEVM const* builtin = nullptr;
+		FunctionCall const* call = nullptr;
+		if (auto const* expressionStatement = get_if<ExpressionStatement>(&statement))
+			if ((call = get_if<FunctionCall>(&expressionStatement->expression)))
+				builtin = m_dialect.builtin(call->functionName.name);
+
+		bool const argumentsMovable = call && all_of(
+			call->arguments.begin(),
+			call->arguments.end(),
+			[&](Expression const& _argument) { return movable(_argument); }
+		);
+
+		if (builtin && builtin->instruction && argumentsMovable)
+		{
+			Instruction instruction = *builtin->instruction;
+			if (instruction == Instruction::SSTORE || instruction == Instruction::MSTORE)
+			{
+				if (instruction == Instruction::MSTORE && !m_optimizeMemory)
+					continue;
+				if (optional<Location> storeLocation = location(call->arguments.front()))
+				{
+					auto key = make_pair(instruction, move(*storeLocation));
+					if (pendingStores.count(key))
+						deadStores.insert(pendingStores[key]);
+					pendingStores[move(key)] = index;
+				}
+				continue;
+			}
+			if (builtin->controlFlowSideEffects.terminates)
+			{
+				if (builtin->controlFlowSideEffects.reverts)
+					removePending(Instruction::SSTORE);
+				if (instruction != Instruction::RETURN && instruction != Instruction::REVERT)
+					removePending(Instruction::MSTORE);
+				pendingStores.clear();
+				continue;
+			}
+		}
+
+		bool readsNothing = std::visit(util::GenericVisitor{
+			[&](ExpressionStatement const& _statement) { return movable(_statement.expression); },
+			[&](VariableDeclaration const& _declaration) { return !_declaration.value || movable(*_declaration.value); },
+			[&](Assignment const& _assignment) { return movable(*_assignment.value); },
+			[&](FunctionDefinition const&) { return true; },
+			[&](auto const&) { return false; }
+		}, statement);
+		if (!readsNothing)
+			pendingStores.clear();
+	}
+
+	if (deadStores.empty())
+		return;
+
+	vector<Statement> statements;
+	for (size_t index = 0; index < _block.statements.size(); ++index)
+		if (!deadStores.count(index))
+			statements.emplace_back(move(_block.statements[index]));
+	_block.statements = move(statements);
+}
+
+bool DeadStoreEliminator::movable(Expression const& _expression) const
+{
+	return SideEffectsCollector{m_dialect, _expression, &m_functionSideEffects}.movable();
+}
+
+optional<DeadStoreEliminator::Location> DeadStoreEliminator::location(Expression const& _key) const
+{
+	if (auto const* literal = get_if<Literal>(&_key))
+		return Location{valueOfLiteral(*literal)};
+	if (auto const* identifier = get_if<Identifier>(&_key))
+		if (!m_assignedVariables.count(identifier->name))
+			return Location{identifier->name};
+	return nullopt;
+}
@@ -0,0 +1,117 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that removes ``sstore`` and ``mstore`` statements whose
+ * value can never be read.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/SideEffects.h>
+#include <libyul/YulString.h>
+
+#include <libsolutil/Common.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <variant>
+
+namespace solidity::yul
+{
+
+struct EVMDialect;
+
+/**
+ * Optimisation stage that removes ``sstore(k, v)`` and ``mstore(k, v)`` statements
+ * whose value cannot be read before it is overwritten or discarded.
+ *
+ * Only straight-line code inside a single block is considered. Each statement of a
+ * block is visited in order, keeping track of the stores to known locations that
+ * were not read since. A location is known if it is a literal or a variable that is
+ * never re-assigned. The value of a tracked store is movable.
+ *
+ * A tracked store is removed if
+ *  - a later store writes to the same location,
+ *  - a later terminating builtin reverts (storage only) or
+ *  - a later terminating builtin does not read memory (memory only).
+ * Statements that are movable, stores with movable arguments and function definitions
+ * do not read storage or memory. Any other statement ends the tracking of all stores.
+ *
+ * Example:
+ *
+ * {
+ *   let x := calldataload(0)
+ *   sstore(x, 1)
+ *   mstore(0, x)
+ *   sstore(x, 2)
+ *   revert(0, 0)
+ * }
+ *
+ * is transformed into
+ *
+ * {
+ *   let x := calldataload(0)
+ *   mstore(0, x)
+ *   revert(0, 0)
+ * }
+ *
+ * Memory stores are only removed if ``msize`` is not used.
+ *
+ * Works best if the code is in SSA form.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class DeadStoreEliminator: public ASTModifier
+{
+public:
+	static constexpr char const* name{"DeadStoreEliminator"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+private:
+	/// A storage or memory location, given by a variable name or a literal value.
+	using Location = std::variant<YulString, u256>;
+
+	DeadStoreEliminator(
+		EVMDialect const& _dialect,
+		std::map<YulString, SideEffects> _functionSideEffects,
+		std::set<YulString> _assignedVariables,
+		bool _optimizeMemory
+	):
+		m_dialect(_dialect),
+		m_functionSideEffects(std::move(_functionSideEffects)),
+		m_assignedVariables(std::move(_assignedVariables)),
+		m_optimizeMemory(_optimizeMemory)
+	{}
+
+	bool movable(Expression const& _expression) const;
+	/// @returns the location of @a _key if it is known.
+	std::optional<Location> location(Expression const& _key) const;
+
+	EVMDialect const& m_dialect;
+	std::map<YulString, SideEffects> m_functionSideEffects;
+	/// Variables that are assigned to and thus cannot be used as location.
+	std::set<YulString> m_assignedVariables;
+	bool m_optimizeMemory = false;
+};
+
+}
@@ -27,6 +27,8 @@
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AsmData.h>
 #include <libyul/Dialect.h>
@@ -40,6 +42,71 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
+namespace
+{
+
+/**
+ * Checks whether a function reads and writes a single storage slot given by a parameter
+ * and otherwise only performs movable computations.
+ */
+class StorageUpdateChecker: public ASTWalker
+{
+public:
+	/// @returns the index of the parameter that is the storage slot if @a _function is
+	/// a storage update function.
+	static std::optional<size_t> slotParameter(EVMDialect const& _dialect, FunctionDefinition const& _function)
+	{
+		if (!_function.returnVariables.empty())
+			return {};
+		StorageUpdateChecker checker{_dialect};
+		checker(_function.body);
+		if (!checker.m_valid || !checker.m_reads || !checker.m_writes || checker.m_slots.size() != 1)
+			return {};
+		Assignments assignments;
+		assignments(_function.body);
+		YulString slot = *checker.m_slots.begin();
+		if (assignments.names().count(slot))
+			return {};
+		for (size_t i = 0; i < _function.parameters.size(); ++i)
+			if (_function.parameters[i].name == slot)
+				return i;
+		return {};
+	}
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _funCall) override
+	{
+		ASTWalker::operator()(_funCall);
+		BuiltinFunctionForEVM const* builtin = m_dialect.builtin(_funCall.functionName.name);
+		if (!builtin || !builtin->instruction)
+			m_valid = false;
+		else if (
+			*builtin->instruction == evmasm::Instruction::SLOAD ||
+			*builtin->instruction == evmasm::Instruction::SSTORE
+		)
+		{
+			(*builtin->instruction == evmasm::Instruction::SLOAD ? m_reads : m_writes) = true;
+			if (Identifier const* slot = get_if<Identifier>(&_funCall.arguments.front()))
+				m_slots.insert(slot->name);
+			else
+				m_valid = false;
+		}
+		else if (!builtin->sideEffects.movable)
+			m_valid = false;
+	}
+
+private:
+	explicit StorageUpdateChecker(EVMDialect const& _dialect): m_dialect(_dialect) {}
+
+	EVMDialect const& m_dialect;
+	bool m_valid = true;
+	bool m_reads = false;
+	bool m_writes = false;
+	set<YulString> m_slots;
+};
+
+}
+
 void FullInliner::run(OptimiserStepContext& _context, Block& _ast)
 {
 	FullInliner{_ast, _context.dispenser, _context.dialect}.run();
@@ -69,6 +136,9 @@ FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const&
 		// Always inline functions that are only called once.
 		if (references[fun.name] == 1)
 			m_singleUse.emplace(fun.name);
+		if (auto const* evmDialect = dynamic_cast<EVMDialect const*>(&m_dialect))
+			if (auto slotParameter = StorageUpdateChecker::slotParameter(*evmDialect, fun))
+				m_storageUpdateFunctions[fun.name] = *slotParameter;
 		updateCodeSize(fun);
 	}
 }
@@ -88,7 +158,7 @@ void FullInliner::run()
 	}
 }
 
-bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
+bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite, bool _adjacentStorageUpdate)
 {
 	// No recursive inlining
 	if (_funCall.functionName.name == _callSite)
@@ -110,6 +180,10 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 	if (m_functionSizes.at(_callSite) > 45)
 		return false;
 
+	// Adjacent updates of the same storage slot can be combined after inlining.
+	if (_adjacentStorageUpdate)
+		return true;
+
 	if (m_singleUse.count(calledFunction->name))
 		return true;
 
@@ -133,6 +207,42 @@ void FullInliner::tentativelyUpdateCodeSize(YulString _function, YulString _call
 	m_functionSizes.at(_callSite) += m_functionSizes.at(_function);
 }
 
+set<FunctionCall const*> FullInliner::adjacentStorageUpdates(Block const& _block) const
+{
+	set<FunctionCall const*> adjacentUpdates;
+	FunctionCall const* previous = nullptr;
+	auto slot = [&](FunctionCall const& _call) -> Expression const& {
+		return _call.arguments.at(m_storageUpdateFunctions.at(_call.functionName.name));
+	};
+	for (Statement const& statement: _block.statements)
+	{
+		FunctionCall const* call = nullptr;
+		if (auto const* expressionStatement = get_if<ExpressionStatement>(&statement))
+			call = get_if<FunctionCall>(&expressionStatement->expression);
+		if (
+			call &&
+			m_storageUpdateFunctions.count(call->functionName.name) &&
+			(holds_alternative<Identifier>(slot(*call)) || holds_alternative<Literal>(slot(*call)))
+		)
+		{
+			if (previous && SyntacticallyEqual{}(slot(*previous), slot(*call)))
+			{
+				adjacentUpdates.insert(previous);
+				adjacentUpdates.insert(call);
+			}
+			previous = call;
+		}
+		else if (auto const* varDecl = get_if<VariableDeclaration>(&statement))
+		{
+			if (varDecl->value && !SideEffectsCollector{m_dialect, *varDecl->value}.movable())
+				previous = nullptr;
+		}
+		else
+			previous = nullptr;
+	}
+	return adjacentUpdates;
+}
+
 void FullInliner::updateCodeSize(FunctionDefinition const& _fun)
 {
 	m_functionSizes[_fun.name] = CodeSize::codeSize(_fun.body);
@@ -155,7 +265,11 @@ void InlineModifier::operator()(Block& _block)
 		visit(_statement);
 		return tryInlineStatement(_statement);
 	};
+	// The calls are only valid while this block is visited, nested blocks use their own.
+	set<FunctionCall const*> adjacentStorageUpdates = m_driver.adjacentStorageUpdates(_block);
+	swap(adjacentStorageUpdates, m_adjacentStorageUpdates);
 	util::iterateReplacing(_block.statements, f);
+	swap(adjacentStorageUpdates, m_adjacentStorageUpdates);
 }
 
 std::optional<vector<Statement>> InlineModifier::tryInlineStatement(Statement& _statement)
@@ -174,7 +288,7 @@ std::optional<vector<Statement>> InlineModifier::tryInlineStatement(Statement& _
 			util::VisitorFallback<FunctionCall*>{},
 			[](FunctionCall& _e) { return &_e; }
 		}, *e);
-		if (funCall && m_driver.shallInline(*funCall, m_currentFunction))
+		if (funCall && m_driver.shallInline(*funCall, m_currentFunction, m_adjacentStorageUpdates.count(funCall)))
 			return performInline(_statement, *funCall);
 	}
 	return {};
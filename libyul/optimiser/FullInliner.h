@@ -62,6 +62,12 @@ class NameCollector;
  * code of f, with replacements: a -> f_a, b -> f_b, c -> f_c
  * let z := f_c
  *
+ * Functions that update a single storage slot given as an argument (a read-modify-write
+ * as used for packed storage variables) are inlined regardless of their size at adjacent
+ * call sites that update the same slot, unless the calling function is already large,
+ * so that the LoadResolver and the DeadStoreEliminator can combine the updates into a
+ * single load and store.
+ *
  * Prerequisites: Disambiguator
  * More efficient if run after: Function Hoister, Expression Splitter
  */
@@ -73,7 +79,9 @@ public:
 
 	/// Inlining heuristic.
 	/// @param _callSite the name of the function in which the function call is located.
-	bool shallInline(FunctionCall const& _funCall, YulString _callSite);
+	/// @param _adjacentStorageUpdate whether the call updates the same storage slot as
+	/// the call in the preceding or following statement.
+	bool shallInline(FunctionCall const& _funCall, YulString _callSite, bool _adjacentStorageUpdate = false);
 
 	FunctionDefinition* function(YulString _name)
 	{
@@ -88,6 +96,10 @@ public:
 	/// should be determined after inlining is completed.
 	void tentativelyUpdateCodeSize(YulString _function, YulString _callSite);
 
+	/// @returns the calls to storage update functions in @a _block that update the same
+	/// slot as the call in the preceding or following statement.
+	std::set<FunctionCall const*> adjacentStorageUpdates(Block const& _block) const;
+
 private:
 	FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect);
 	void run();
@@ -106,6 +118,9 @@ private:
 	std::set<YulString> m_singleUse;
 	/// Variables that are constants (used for inlining heuristic)
 	std::set<YulString> m_constants;
+	/// Index of the parameter that specifies the storage slot, for each function that only
+	/// reads and writes this slot.
+	std::map<YulString, size_t> m_storageUpdateFunctions;
 	std::map<YulString, size_t> m_functionSizes;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
@@ -132,6 +147,9 @@ private:
 	std::vector<Statement> performInline(Statement& _statement, FunctionCall& _funCall);
 
 	YulString m_currentFunction;
+	/// Calls to storage update functions in the block that is currently visited
+	/// that are next to an update of the same slot.
+	std::set<FunctionCall const*> m_adjacentStorageUpdates;
 	FullInliner& m_driver;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
@@ -0,0 +1,241 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that creates copies of functions specialised to constant arguments.
+ */
+
+#include <libyul/optimiser/FunctionSpecializer.h>
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmData.h>
+
+#include <libevmasm/GasMeter.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Maximum number of specialised copies of a function created in one run.
+size_t constexpr maxSpecializationsPerFunction = 4;
+/// Approximate gas saved per call for each reference to a constant parameter.
+size_t constexpr gasPerConstantReference = 10;
+/// Approximate number of bytes per unit of code size.
+size_t constexpr bytesPerCodeSize = 2;
+/// Expected number of executions if the ``runs`` parameter of the optimiser is not known.
+size_t constexpr defaultExpectedExecutions = 200;
+
+}
+
+void FunctionSpecializer::run(OptimiserStepContext& _context, Block& _ast)
+{
+	if (!dynamic_cast<EVMDialect const*>(&_context.dialect))
+		return;
+
+	FunctionSpecializer specializer{
+		_context.dialect,
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
+		_context.dispenser,
+		_context.expectedExecutionsPerDeployment.value_or(defaultExpectedExecutions)
+	};
+	specializer(_ast);
+	specializer.specialize(_ast);
+}
+
+void FunctionSpecializer::operator()(FunctionCall& _funCall)
+{
+	DataFlowAnalyzer::operator()(_funCall);
+
+	YulString functionName = _funCall.functionName.name;
+	if (m_dialect.builtin(functionName) || functionName == m_currentFunction)
+		return;
+
+	ArgumentPattern pattern;
+	bool constantArgument = false;
+	for (Expression const& argument: _funCall.arguments)
+	{
+		optional<u256> value;
+		if (holds_alternative<Literal>(argument) || holds_alternative<Identifier>(argument))
+			value = m_knowledgeBase.valueIfKnownConstant(argument);
+		constantArgument = constantArgument || value.has_value();
+		pattern.emplace_back(move(value));
+	}
+	if (constantArgument)
+	{
+		m_calls[functionName][move(pattern)].emplace_back(m_recordedCalls.size());
+		m_recordedCalls.emplace_back(&_funCall);
+	}
+}
+
+void FunctionSpecializer::operator()(FunctionDefinition& _funDef)
+{
+	m_currentFunction = _funDef.name;
+	DataFlowAnalyzer::operator()(_funDef);
+	m_currentFunction = {};
+}
+
+void FunctionSpecializer::specialize(Block& _ast)
+{
+	map<YulString, FunctionDefinition const*> functions;
+	for (Statement const& statement: _ast.statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+			functions[function->name] = function;
+	map<YulString, size_t> references = ReferencesCounter::countReferences(_ast);
+
+	// The replacement for each recorded call, determined before any call is modified.
+	vector<pair<ArgumentPattern const*, YulString>> replacements(m_recordedCalls.size());
+	vector<Statement> newFunctions;
+	for (auto& [functionName, patterns]: m_calls)
+	{
+		if (!functions.count(functionName))
+			continue;
+		FunctionDefinition const& function = *functions.at(functionName);
+		if (ReferencesCounter::countReferences(function.body).count(functionName))
+			continue;
+
+		// If all calls use the same pattern, the original function becomes unused.
+		bool allCalls =
+			patterns.size() == 1 &&
+			patterns.begin()->second.size() == references[functionName];
+
+		// Prefer the patterns that are used most often.
+		vector<pair<ArgumentPattern const*, vector<size_t>*>> candidates;
+		for (auto& [pattern, calls]: patterns)
+			candidates.emplace_back(&pattern, &calls);
+		stable_sort(candidates.begin(), candidates.end(), [](auto const& _a, auto const& _b) {
+			return _a.second->size() > _b.second->size();
+		});
+
+		size_t specializations = 0;
+		for (auto const& [pattern, calls]: candidates)
+		{
+			if (specializations == maxSpecializationsPerFunction)
+				break;
+			if (!allCalls && !worthSpecializing(function, *pattern, calls->size()))
+				continue;
+
+			YulString newName = m_nameDispenser.newName(functionName);
+			for (size_t call: *calls)
+				replacements[call] = {pattern, newName};
+			newFunctions.emplace_back(specializedCopy(function, *pattern, newName));
+			++specializations;
+		}
+	}
+
+	// Calls are recorded after the calls nested in their arguments. Modifying them in the
+	// same order ensures that the nested calls are not moved before they are modified.
+	for (size_t i = 0; i < m_recordedCalls.size(); ++i)
+		if (auto const& [pattern, newName] = replacements[i]; pattern)
+		{
+			FunctionCall& call = *m_recordedCalls[i];
+			vector<Expression> arguments;
+			for (size_t j = 0; j < pattern->size(); ++j)
+				if (!(*pattern)[j])
+					arguments.emplace_back(move(call.arguments[j]));
+			call.arguments = move(arguments);
+			call.functionName.name = newName;
+		}
+	m_calls.clear();
+	m_recordedCalls.clear();
+
+	_ast.statements += move(newFunctions);
+}
+
+bool FunctionSpecializer::worthSpecializing(
+	FunctionDefinition const& _function,
+	ArgumentPattern const& _pattern,
+	size_t _calls
+) const
+{
+	map<YulString, size_t> references =
+		ReferencesCounter::countReferences(_function.body, ReferencesCounter::OnlyVariables);
+
+	// Each constant argument also saves pushing it at the call site.
+	size_t constantReferences = 0;
+	for (size_t i = 0; i < _pattern.size(); ++i)
+		if (_pattern[i])
+			constantReferences += 1 + (references.count(_function.parameters[i].name) ?
+				references.at(_function.parameters[i].name) :
+				0
+			);
+
+	size_t savedGas = _calls * constantReferences * gasPerConstantReference * m_expectedExecutions;
+	size_t additionalCodeGas =
+		CodeSize::codeSize(_function.body) * bytesPerCodeSize * evmasm::GasCosts::createDataGas;
+	return savedGas >= additionalCodeGas;
+}
+
+FunctionDefinition FunctionSpecializer::specializedCopy(
+	FunctionDefinition const& _function,
+	ArgumentPattern const& _pattern,
+	YulString _name
+)
+{
+	langutil::SourceLocation const& location = _function.location;
+	map<YulString, YulString> variableReplacements;
+	auto copyVariable = [&](TypedName const& _variable) {
+		YulString newName = m_nameDispenser.newName(_variable.name);
+		variableReplacements[_variable.name] = newName;
+		return TypedName{_variable.location, newName, _variable.type};
+	};
+
+	TypedNameList parameters;
+	vector<Statement> constantParameters;
+	for (size_t i = 0; i < _function.parameters.size(); ++i)
+	{
+		TypedName parameter = copyVariable(_function.parameters[i]);
+		if (_pattern[i])
+			constantParameters.emplace_back(VariableDeclaration{
+				location,
+				{parameter},
+				make_unique<Expression>(Literal{
+					location,
+					LiteralKind::Number,
+					YulString{util::formatNumber(*_pattern[i])},
+					parameter.type
+				})
+			});
+		else
+			parameters.emplace_back(move(parameter));
+	}
+	TypedNameList returnVariables;
+	for (TypedName const& returnVariable: _function.returnVariables)
+		returnVariables.emplace_back(copyVariable(returnVariable));
+
+	Block body = std::get<Block>(BodyCopier{m_nameDispenser, variableReplacements}(_function.body));
+	body.statements = move(constantParameters) + move(body.statements);
+
+	return FunctionDefinition{
+		location,
+		_name,
+		move(parameters),
+		move(returnVariables),
+		move(body)
+	};
+}
@@ -0,0 +1,119 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that creates copies of functions specialised to constant arguments.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <libsolutil/Common.h>
+
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace solidity::yul
+{
+
+class NameDispenser;
+struct SideEffects;
+
+/**
+ * Optimisation stage that replaces calls to functions with constant arguments by
+ * calls to copies of the functions, in which the respective parameters are replaced
+ * by variables initialised to the constants. Arguments are considered constant if they
+ * are literals or variables whose value is known to be constant.
+ *
+ * function f(a, b) -> r { r := add(a, b) }
+ * let x := f(7, calldataload(0))
+ *
+ * is transformed into
+ *
+ * function f(a, b) -> r { r := add(a, b) }
+ * function f_1(b_2) -> r_3 { let a_4 := 7 r_3 := add(a_4, b_2) }
+ * let x := f_1(calldataload(0))
+ *
+ * The copies are simplified by the following steps and identical copies are combined
+ * by the EquivalentFunctionCombiner. The original function is removed by the
+ * UnusedPruner if all calls have been replaced.
+ *
+ * If all calls to a function use the same constant arguments, the function is always
+ * specialised, since the original function becomes unused. Otherwise, a copy is only
+ * created if the gas saved in the calls, estimated from the number of references to
+ * the constant parameters and multiplied by the expected number of executions (the ``runs``
+ * parameter of the optimiser), outweighs the cost of deploying the copy. At most
+ * ``maxSpecializationsPerFunction`` copies are created per function in one run.
+ * Recursive functions are not specialised.
+ *
+ * Only runs for EVM dialects.
+ *
+ * Prerequisite: Disambiguator, FunctionHoister, FunctionGrouper, ForLoopInitRewriter.
+ * Works best if the code is in SSA form.
+ */
+class FunctionSpecializer: public DataFlowAnalyzer
+{
+public:
+	static constexpr char const* name{"FunctionSpecializer"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	using DataFlowAnalyzer::operator();
+	void operator()(FunctionCall& _funCall) override;
+	void operator()(FunctionDefinition& _funDef) override;
+
+private:
+	/// The values of the constant arguments of a call, nullopt for other arguments.
+	using ArgumentPattern = std::vector<std::optional<u256>>;
+
+	FunctionSpecializer(
+		Dialect const& _dialect,
+		std::map<YulString, SideEffects> _functionSideEffects,
+		NameDispenser& _nameDispenser,
+		size_t _expectedExecutions
+	):
+		DataFlowAnalyzer(_dialect, std::move(_functionSideEffects)),
+		m_nameDispenser(_nameDispenser),
+		m_expectedExecutions(_expectedExecutions)
+	{}
+
+	/// Creates the specialised copies of the functions defined in @a _ast and
+	/// redirects the calls to them.
+	void specialize(Block& _ast);
+	/// @returns true if creating a copy of @a _function for the argument pattern @a _pattern,
+	/// which is used in @a _calls calls, is expected to be cheaper overall.
+	bool worthSpecializing(FunctionDefinition const& _function, ArgumentPattern const& _pattern, size_t _calls) const;
+	/// @returns a copy of @a _function named @a _name with the constant parameters in @a _pattern
+	/// replaced by variables.
+	FunctionDefinition specializedCopy(
+		FunctionDefinition const& _function,
+		ArgumentPattern const& _pattern,
+		YulString _name
+	);
+
+	NameDispenser& m_nameDispenser;
+	size_t m_expectedExecutions;
+	/// Function whose body is currently visited.
+	YulString m_currentFunction;
+	/// Calls with at least one constant argument, in the order in which they were visited.
+	std::vector<FunctionCall*> m_recordedCalls;
+	/// Indices into m_recordedCalls, grouped by function and argument pattern.
+	std::map<YulString, std::map<ArgumentPattern, std::vector<size_t>>> m_calls;
+};
+
+}
@@ -35,16 +35,21 @@ using namespace solidity;
 using namespace solidity::yul;
 
 bool KnowledgeBase::knownToBeDifferent(YulString _a, YulString _b)
+{
+	return knownToBeDifferent(_a, Identifier{{}, _b});
+}
+
+bool KnowledgeBase::knownToBeDifferent(YulString _a, Expression const& _b)
 {
 	// Try to use the simplification rules together with the
 	// current values to turn `sub(_a, _b)` into a nonzero constant.
 	// If that fails, try `eq(_a, _b)`.
 
-	Expression expr1 = simplify(FunctionCall{{}, {{}, "sub"_yulstring}, util::make_vector<Expression>(Identifier{{}, _a}, Identifier{{}, _b})});
+	Expression expr1 = simplify(FunctionCall{{}, {{}, "sub"_yulstring}, util::make_vector<Expression>(Identifier{{}, _a}, _b)});
 	if (holds_alternative<Literal>(expr1))
 		return valueOfLiteral(std::get<Literal>(expr1)) != 0;
 
-	Expression expr2 = simplify(FunctionCall{{}, {{}, "eq"_yulstring}, util::make_vector<Expression>(Identifier{{}, _a}, Identifier{{}, _b})});
+	Expression expr2 = simplify(FunctionCall{{}, {{}, "eq"_yulstring}, util::make_vector<Expression>(Identifier{{}, _a}, _b)});
 	if (holds_alternative<Literal>(expr2))
 		return valueOfLiteral(std::get<Literal>(expr2)) == 0;
 
@@ -52,11 +57,16 @@ bool KnowledgeBase::knownToBeDifferent(YulString _a, YulString _b)
 }
 
 bool KnowledgeBase::knownToBeDifferentByAtLeast32(YulString _a, YulString _b)
+{
+	return knownToBeDifferentByAtLeast32(_a, Identifier{{}, _b});
+}
+
+bool KnowledgeBase::knownToBeDifferentByAtLeast32(YulString _a, Expression const& _b)
 {
 	// Try to use the simplification rules together with the
 	// current values to turn `sub(_a, _b)` into a constant whose absolute value is at least 32.
 
-	Expression expr1 = simplify(FunctionCall{{}, {{}, "sub"_yulstring}, util::make_vector<Expression>(Identifier{{}, _a}, Identifier{{}, _b})});
+	Expression expr1 = simplify(FunctionCall{{}, {{}, "sub"_yulstring}, util::make_vector<Expression>(Identifier{{}, _a}, _b)});
 	if (holds_alternative<Literal>(expr1))
 	{
 		u256 val = valueOfLiteral(std::get<Literal>(expr1));
@@ -66,6 +76,19 @@ bool KnowledgeBase::knownToBeDifferentByAtLeast32(YulString _a, YulString _b)
 	return false;
 }
 
+optional<u256> KnowledgeBase::valueIfKnownConstant(YulString _a)
+{
+	return valueIfKnownConstant(Identifier{{}, _a});
+}
+
+optional<u256> KnowledgeBase::valueIfKnownConstant(Expression const& _expression)
+{
+	Expression expr = simplify(_expression);
+	if (holds_alternative<Literal>(expr))
+		return valueOfLiteral(std::get<Literal>(expr));
+	return nullopt;
+}
+
 Expression KnowledgeBase::simplify(Expression _expression)
 {
 	bool startedRecursion = (m_recursionCounter == 0);
@@ -81,6 +104,14 @@ Expression KnowledgeBase::simplify(Expression _expression)
 	if (holds_alternative<FunctionCall>(_expression))
 		for (Expression& arg: std::get<FunctionCall>(_expression).arguments)
 			arg = simplify(arg);
+	else if (holds_alternative<Identifier>(_expression))
+	{
+		// Replace variables with known constant values, so that rules like
+		// ``sub(X, 0) -> X`` do not prevent constant folding.
+		auto it = m_variableValues.find(std::get<Identifier>(_expression).name);
+		if (it != m_variableValues.end() && it->second.value && holds_alternative<Literal>(*it->second.value))
+			return *it->second.value;
+	}
 
 	if (auto match = SimplificationRules::findFirstMatch(_expression, m_dialect, m_variableValues))
 		return simplify(match->action().toExpression(locationOf(_expression)));
@@ -22,7 +22,11 @@
 
 #include <libyul/AsmDataForward.h>
 #include <libyul/YulString.h>
+
+#include <libsolutil/Common.h>
+
 #include <map>
+#include <optional>
 
 namespace solidity::yul
 {
@@ -44,9 +48,17 @@ public:
 	{}
 
 	bool knownToBeDifferent(YulString _a, YulString _b);
+	/// Variant of the above where the second operand can be an identifier or a literal.
+	bool knownToBeDifferent(YulString _a, Expression const& _b);
 	bool knownToBeDifferentByAtLeast32(YulString _a, YulString _b);
+	bool knownToBeDifferentByAtLeast32(YulString _a, Expression const& _b);
 	bool knownToBeEqual(YulString _a, YulString _b) const { return _a == _b; }
 
+	/// @returns the value of @a _a if it is known to be a constant.
+	std::optional<u256> valueIfKnownConstant(YulString _a);
+	/// Variant of the above for an identifier or a literal.
+	std::optional<u256> valueIfKnownConstant(Expression const& _expression);
+
 private:
 	Expression simplify(Expression _expression);
 
@@ -16,7 +16,7 @@
 */
 /**
  * Optimisation stage that replaces expressions of type ``sload(x)`` by the value
- * currently stored in storage, if known.
+ * currently stored in storage, if known, and evaluates ``keccak256`` over known memory.
  */
 
 #include <libyul/optimiser/LoadResolver.h>
@@ -26,6 +26,11 @@
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/SideEffects.h>
 #include <libyul/AsmData.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
 
 using namespace std;
 using namespace solidity;
@@ -37,6 +42,7 @@ void LoadResolver::run(OptimiserStepContext& _context, Block& _ast)
 	LoadResolver{
 		_context.dialect,
 		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
+		WrittenLocationsPropagator::writtenLocations(_context.dialect, _ast),
 		!containsMSize
 	}(_ast);
 }
@@ -53,7 +59,12 @@ void LoadResolver::visit(Expression& _e)
 		FunctionCall const& funCall = std::get<FunctionCall>(_e);
 		if (auto const* builtin = dynamic_cast<EVMDialect const&>(m_dialect).builtin(funCall.functionName.name))
 			if (builtin->instruction)
-				tryResolve(_e, *builtin->instruction, funCall.arguments);
+			{
+				if (*builtin->instruction == evmasm::Instruction::KECCAK256)
+					tryEvaluateKeccak(_e, funCall.arguments);
+				else
+					tryResolve(_e, *builtin->instruction, funCall.arguments);
+			}
 	}
 }
 
@@ -79,3 +90,44 @@ void LoadResolver::tryResolve(
 	)
 		_e = Identifier{locationOf(_e), m_memory.values[key]};
 }
+
+void LoadResolver::tryEvaluateKeccak(Expression& _e, vector<Expression> const& _arguments)
+{
+	yulAssert(_arguments.size() == 2, "");
+	// Removing the call would change the result of msize.
+	if (!m_optimizeMLoad)
+		return;
+	for (Expression const& argument: _arguments)
+		if (!holds_alternative<Identifier>(argument) && !holds_alternative<Literal>(argument))
+			return;
+
+	optional<u256> start = m_knowledgeBase.valueIfKnownConstant(_arguments.at(0));
+	optional<u256> length = m_knowledgeBase.valueIfKnownConstant(_arguments.at(1));
+	if (!start || !length || *length > maxKeccakLength || *length % 32 != 0)
+		return;
+
+	// Values of the words starting at offset i * 32.
+	vector<optional<u256>> words(size_t(*length / 32));
+	for (auto const& [location, value]: m_memory.values)
+	{
+		optional<u256> offset = m_knowledgeBase.valueIfKnownConstant(location);
+		if (!offset || *offset < *start || *offset - *start >= *length || (*offset - *start) % 32 != 0)
+			continue;
+		if (optional<u256> wordValue = m_knowledgeBase.valueIfKnownConstant(value))
+			words[size_t((*offset - *start) / 32)] = wordValue;
+	}
+
+	bytes data;
+	for (optional<u256> const& word: words)
+	{
+		if (!word)
+			return;
+		data += util::toBigEndian(*word);
+	}
+	_e = Literal{
+		locationOf(_e),
+		LiteralKind::Number,
+		YulString{util::formatNumber(u256(util::keccak256(data)))},
+		{}
+	};
+}
@@ -16,7 +16,7 @@
 */
 /**
  * Optimisation stage that replaces expressions of type ``sload(x)`` by the value
- * currently stored in storage, if known.
+ * currently stored in storage, if known, and evaluates ``keccak256`` over known memory.
  */
 
 #pragma once
@@ -35,6 +35,11 @@ struct BuiltinFunctionForEVM;
  * Optimisation stage that replaces expressions of type ``sload(x)`` and ``mload(x)`` by the value
  * currently stored in storage resp. memory, if known.
  *
+ * Also replaces ``keccak256(p, n)`` by its result if ``p`` and ``n`` are known constants,
+ * ``n`` is a multiple of 32 of at most ``maxKeccakLength`` and the memory area
+ * is known to contain constant values, like in the computation of a mapping slot
+ * with a constant key.
+ *
  * Works best if the code is in SSA form.
  *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
@@ -50,9 +55,10 @@ private:
 	LoadResolver(
 		Dialect const& _dialect,
 		std::map<YulString, SideEffects> _functionSideEffects,
+		std::map<YulString, FunctionWrites> _functionWrites,
 		bool _optimizeMLoad
 	):
-		DataFlowAnalyzer(_dialect, std::move(_functionSideEffects)),
+		DataFlowAnalyzer(_dialect, std::move(_functionSideEffects), std::move(_functionWrites)),
 		m_optimizeMLoad(_optimizeMLoad)
 	{}
 
@@ -66,6 +72,13 @@ protected:
 		std::vector<Expression> const& _arguments
 	);
 
+	/// Replaces the call to ``keccak256`` @a _e by its value if the arguments and
+	/// the memory contents are known constants.
+	void tryEvaluateKeccak(Expression& _e, std::vector<Expression> const& _arguments);
+
+	/// Maximum length of memory areas whose hash is computed at compile time.
+	static size_t constexpr maxKeccakLength = 128;
+
 	bool m_optimizeMLoad = false;
 };
 
@@ -0,0 +1,211 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that unrolls for loops with a small constant number of iterations.
+ */
+
+#include <libyul/optimiser/LoopUnroller.h>
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/Substitution.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmData.h>
+
+#include <libevmasm/GasMeter.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Maximum number of iterations of loops that are unrolled.
+size_t constexpr maxIterations = 16;
+/// Maximum size of the code that replaces an unrolled loop.
+size_t constexpr maxUnrolledSize = 256;
+/// Approximate gas costs of evaluating the condition of a loop and jumping back in each iteration.
+size_t constexpr iterationGas = 30;
+/// Approximate number of bytes per unit of code size.
+size_t constexpr bytesPerCodeSize = 2;
+/// Expected number of executions if the ``runs`` parameter of the optimiser is not known.
+size_t constexpr defaultExpectedExecutions = 200;
+
+/**
+ * Checks that the body of a loop can be copied, i.e. that it does not contain
+ * function definitions or ``break`` and ``continue`` statements of the loop itself.
+ */
+class CopyableBodyChecker: public ASTWalker
+{
+public:
+	static bool copyable(Block const& _body)
+	{
+		CopyableBodyChecker checker;
+		checker(_body);
+		return checker.m_copyable;
+	}
+
+	using ASTWalker::operator();
+	void operator()(ForLoop const& _loop) override
+	{
+		++m_loopDepth;
+		ASTWalker::operator()(_loop);
+		--m_loopDepth;
+	}
+	void operator()(Break const&) override { m_copyable = m_copyable && m_loopDepth > 0; }
+	void operator()(Continue const&) override { m_copyable = m_copyable && m_loopDepth > 0; }
+	void operator()(FunctionDefinition const&) override { m_copyable = false; }
+
+private:
+	size_t m_loopDepth = 0;
+	bool m_copyable = true;
+};
+
+}
+
+void LoopUnroller::run(OptimiserStepContext& _context, Block& _ast)
+{
+	if (!dynamic_cast<EVMDialect const*>(&_context.dialect))
+		return;
+
+	LoopUnroller{
+		_context.dialect,
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
+		_context.dispenser,
+		_context.expectedExecutionsPerDeployment.value_or(defaultExpectedExecutions)
+	}(_ast);
+}
+
+void LoopUnroller::visit(Statement& _statement)
+{
+	if (ForLoop* loop = get_if<ForLoop>(&_statement))
+		if (optional<size_t> iterationCount = iterations(*loop))
+			if (worthUnrolling(*iterationCount, CodeSize::codeSize(loop->body) + CodeSize::codeSize(loop->post)))
+			{
+				Block unrolled{loop->location, {}};
+				for (size_t i = 0; i < *iterationCount; ++i)
+				{
+					unrolled.statements.emplace_back(BodyCopier{m_nameDispenser, {}}(loop->body));
+					unrolled.statements.emplace_back(BodyCopier{m_nameDispenser, {}}(loop->post));
+				}
+				_statement = move(unrolled);
+			}
+
+	DataFlowAnalyzer::visit(_statement);
+}
+
+optional<size_t> LoopUnroller::iterations(ForLoop const& _loop)
+{
+	if (!_loop.pre.statements.empty() || !CopyableBodyChecker::copyable(_loop.body))
+		return nullopt;
+
+	SideEffectsCollector conditionSideEffects(m_dialect, *_loop.condition, &m_functionSideEffects);
+	if (!conditionSideEffects.movable() || !conditionSideEffects.sideEffectFree())
+		return nullopt;
+
+	// The condition and the post block have to be evaluated using the values at the start
+	// of the loop and the values computed by the post block only.
+	Assignments assignedInBody;
+	assignedInBody(_loop.body);
+	for (auto const& references: {
+		ReferencesCounter::countReferences(*_loop.condition, ReferencesCounter::OnlyVariables),
+		ReferencesCounter::countReferences(_loop.post, ReferencesCounter::OnlyVariables)
+	})
+		for (auto const& reference: references)
+			if (assignedInBody.names().count(reference.first))
+				return nullopt;
+
+	map<YulString, u256> values;
+	Assignments assignedInPost;
+	assignedInPost(_loop.post);
+	for (YulString variable: assignedInPost.names())
+		if (optional<u256> value = m_knowledgeBase.valueIfKnownConstant(variable))
+			values[variable] = *value;
+		else
+			return nullopt;
+
+	for (size_t iterationCount = 0; ; ++iterationCount)
+	{
+		optional<u256> condition = evaluate(*_loop.condition, values);
+		if (!condition)
+			return nullopt;
+		else if (*condition == 0)
+			return iterationCount;
+		else if (iterationCount == maxIterations)
+			return nullopt;
+
+		for (Statement const& statement: _loop.post.statements)
+		{
+			YulString variable;
+			Expression const* value = nullptr;
+			if (auto const* varDecl = get_if<VariableDeclaration>(&statement))
+			{
+				if (varDecl->variables.size() != 1 || !varDecl->value)
+					return nullopt;
+				variable = varDecl->variables.front().name;
+				value = varDecl->value.get();
+			}
+			else if (auto const* assignment = get_if<Assignment>(&statement))
+			{
+				if (assignment->variableNames.size() != 1)
+					return nullopt;
+				variable = assignment->variableNames.front().name;
+				value = assignment->value.get();
+			}
+			else
+				return nullopt;
+
+			if (optional<u256> newValue = evaluate(*value, values))
+				values[variable] = *newValue;
+			else
+				return nullopt;
+		}
+	}
+}
+
+optional<u256> LoopUnroller::evaluate(Expression const& _expression, map<YulString, u256> const& _values)
+{
+	map<YulString, Expression> literals;
+	map<YulString, Expression const*> substitutions;
+	for (auto const& [variable, value]: _values)
+		substitutions[variable] = &(literals[variable] = Literal{
+			{},
+			LiteralKind::Number,
+			YulString{util::formatNumber(value)},
+			{}
+		});
+	return m_knowledgeBase.valueIfKnownConstant(Substitution{substitutions}.translate(_expression));
+}
+
+bool LoopUnroller::worthUnrolling(size_t _iterations, size_t _size) const
+{
+	if (_iterations <= 1)
+		return true;
+	if (_iterations * _size > maxUnrolledSize)
+		return false;
+
+	// The condition is evaluated once more than the body.
+	size_t savedGas = (_iterations + 1) * iterationGas * m_expectedExecutions;
+	size_t additionalCodeGas = (_iterations - 1) * _size * bytesPerCodeSize * evmasm::GasCosts::createDataGas;
+	return savedGas >= additionalCodeGas;
+}
@@ -0,0 +1,99 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that unrolls for loops with a small constant number of iterations.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <libsolutil/Common.h>
+
+#include <map>
+#include <optional>
+
+namespace solidity::yul
+{
+
+class NameDispenser;
+struct SideEffects;
+
+/**
+ * Optimisation stage that replaces for loops with a small constant number of iterations
+ * by copies of their body and post block.
+ *
+ * The number of iterations is determined by evaluating the condition and the post block
+ * at compile time, starting from the values the variables assigned in the post block
+ * have before the loop. This requires these values to be known constants, the condition
+ * to be movable and the condition and post block to only depend on these variables and on
+ * variables that are not assigned inside the body. Loops whose body contains ``break``
+ * or ``continue`` are not unrolled.
+ *
+ * let i := 0
+ * for { } lt(i, 2) { i := add(i, 1) } { sstore(i, 7) }
+ *
+ * is transformed into
+ *
+ * let i := 0
+ * { { sstore(i, 7) } { i := add(i, 1) } { sstore(i, 7) } { i := add(i, 1) } }
+ *
+ * Loops whose condition is false when entering them are removed.
+ * Other loops are only unrolled if the gas saved by not evaluating the condition,
+ * multiplied by the expected number of executions (the ``runs`` parameter of the
+ * optimiser), outweighs the cost of deploying the additional code.
+ *
+ * Only runs for EVM dialects.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter, FunctionHoister.
+ */
+class LoopUnroller: public DataFlowAnalyzer
+{
+public:
+	static constexpr char const* name{"LoopUnroller"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using ASTModifier::visit;
+	void visit(Statement& _statement) override;
+
+private:
+	LoopUnroller(
+		Dialect const& _dialect,
+		std::map<YulString, SideEffects> _functionSideEffects,
+		NameDispenser& _nameDispenser,
+		size_t _expectedExecutions
+	):
+		DataFlowAnalyzer(_dialect, std::move(_functionSideEffects)),
+		m_nameDispenser(_nameDispenser),
+		m_expectedExecutions(_expectedExecutions)
+	{}
+
+	/// @returns the number of iterations of @a _loop if it is known and at most ``maxIterations``.
+	std::optional<size_t> iterations(ForLoop const& _loop);
+	/// @returns the value of @a _expression if it is a known constant, given that the variables
+	/// in @a _values have the respective values.
+	std::optional<u256> evaluate(Expression const& _expression, std::map<YulString, u256> const& _values);
+	/// @returns true if unrolling a loop with @a _iterations iterations, whose body and
+	/// post block have a combined size of @a _size, is expected to be cheaper overall.
+	bool worthUnrolling(size_t _iterations, size_t _size) const;
+
+	NameDispenser& m_nameDispenser;
+	size_t m_expectedExecutions;
+};
+
+}
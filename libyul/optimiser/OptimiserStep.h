@@ -19,6 +19,7 @@
 
 #include <libyul/Exceptions.h>
 
+#include <optional>
 #include <string>
 #include <set>
 
@@ -35,6 +36,9 @@ struct OptimiserStepContext
 	Dialect const& dialect;
 	NameDispenser& dispenser;
 	std::set<YulString> const& reservedIdentifiers;
+	/// Expected number of executions of the code per deployment
+	/// (the ``runs`` parameter of the optimiser), if known.
+	std::optional<size_t> expectedExecutionsPerDeployment = std::nullopt;
 };
 
 
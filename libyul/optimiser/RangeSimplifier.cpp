@@ -0,0 +1,444 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that replaces comparisons and masks by their value
+ * if it follows from the ranges of the values involved.
+ */
+
+#include <libyul/optimiser/RangeSimplifier.h>
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmData.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Maximum depth when following the values of variables in conditions.
+size_t constexpr maxConditionDepth = 16;
+
+}
+
+void RangeSimplifier::run(OptimiserStepContext& _context, Block& _ast)
+{
+	if (!dynamic_cast<EVMDialect const*>(&_context.dialect))
+		return;
+
+	RangeSimplifier{
+		_context.dialect,
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+	}(_ast);
+}
+
+void RangeSimplifier::operator()(VariableDeclaration& _varDecl)
+{
+	DataFlowAnalyzer::operator()(_varDecl);
+
+	if (_varDecl.variables.size() == 1)
+		setRange(
+			_varDecl.variables.front().name,
+			_varDecl.value ? range(*_varDecl.value) : Range{0, 0}
+		);
+	else
+		for (auto const& variable: _varDecl.variables)
+			m_ranges.erase(variable.name);
+}
+
+void RangeSimplifier::operator()(Assignment& _assignment)
+{
+	DataFlowAnalyzer::operator()(_assignment);
+
+	// The range of the value is still computed from the old ranges,
+	// which is correct even if the value refers to the variable itself.
+	if (_assignment.variableNames.size() == 1)
+		setRange(_assignment.variableNames.front().name, range(*_assignment.value));
+	else
+		for (auto const& variable: _assignment.variableNames)
+			m_ranges.erase(variable.name);
+}
+
+void RangeSimplifier::operator()(If& _if)
+{
+	Ranges bodyRanges = m_ranges;
+	learn(bodyRanges, *_if.condition, true);
+	m_blockRanges[&_if.body] = move(bodyRanges);
+	Ranges rangesIfFalse = m_ranges;
+	learn(rangesIfFalse, *_if.condition, false);
+
+	DataFlowAnalyzer::operator()(_if);
+
+	// If the body does not flow out, the condition was false if execution continues here.
+	TerminationFinder terminationFinder{m_dialect};
+	if (
+		terminationFinder.firstUnconditionalControlFlowChange(_if.body.statements).first !=
+		TerminationFinder::ControlFlow::FlowOut
+	)
+		m_ranges = move(rangesIfFalse);
+}
+
+void RangeSimplifier::operator()(Switch& _switch)
+{
+	for (auto& _case: _switch.cases)
+		if (_case.value)
+		{
+			u256 value = valueOfLiteral(*_case.value);
+			Ranges caseRanges = m_ranges;
+			restrict(caseRanges, *_switch.expression, Range{value, value});
+			m_blockRanges[&_case.body] = move(caseRanges);
+		}
+
+	DataFlowAnalyzer::operator()(_switch);
+}
+
+void RangeSimplifier::operator()(FunctionDefinition& _function)
+{
+	Ranges ranges;
+	vector<Loop> loops;
+	swap(m_ranges, ranges);
+	swap(m_loops, loops);
+
+	for (auto const& variable: _function.returnVariables)
+		setRange(variable.name, Range{0, 0});
+	DataFlowAnalyzer::operator()(_function);
+
+	swap(m_ranges, ranges);
+	swap(m_loops, loops);
+}
+
+void RangeSimplifier::operator()(ForLoop& _for)
+{
+	Assignments assignments;
+	assignments(_for.body);
+	assignments(_for.post);
+	for (YulString name: assignments.names())
+		m_ranges.erase(name);
+	// The condition may only refer to the values the variables have
+	// at the start of any iteration.
+	clearValues(assignments.names());
+
+	Ranges outerRanges = m_ranges;
+	Ranges bodyRanges = m_ranges;
+	learn(bodyRanges, *_for.condition, true);
+	m_blockRanges[&_for.body] = move(bodyRanges);
+
+	m_loops.push_back(Loop{&_for.body, &_for.post, nullopt});
+	DataFlowAnalyzer::operator()(_for);
+	m_loops.pop_back();
+
+	m_ranges = move(outerRanges);
+}
+
+void RangeSimplifier::operator()(Continue& _continue)
+{
+	DataFlowAnalyzer::operator()(_continue);
+
+	if (!m_loops.empty())
+	{
+		optional<Ranges>& postRanges = m_loops.back().postRanges;
+		postRanges = postRanges ? join(*postRanges, m_ranges) : m_ranges;
+	}
+}
+
+void RangeSimplifier::operator()(Block& _block)
+{
+	Ranges outerRanges = m_ranges;
+	if (auto it = m_blockRanges.find(&_block); it != m_blockRanges.end())
+	{
+		m_ranges = move(it->second);
+		m_blockRanges.erase(it);
+	}
+
+	DataFlowAnalyzer::operator()(_block);
+
+	if (!m_loops.empty() && m_loops.back().body == &_block)
+	{
+		Loop& loop = m_loops.back();
+		m_blockRanges[loop.post] = loop.postRanges ? join(*loop.postRanges, m_ranges) : m_ranges;
+	}
+
+	m_ranges = move(outerRanges);
+	Assignments assignments;
+	assignments(_block);
+	for (YulString name: assignments.names())
+		m_ranges.erase(name);
+}
+
+void RangeSimplifier::visit(Expression& _e)
+{
+	FunctionCall* call = get_if<FunctionCall>(&_e);
+	BuiltinFunctionForEVM const* builtin =
+		call ? dynamic_cast<EVMDialect const&>(m_dialect).builtin(call->functionName.name) : nullptr;
+
+	// We should not modify function arguments that have to be literals.
+	if (!builtin || !builtin->literalArguments)
+		DataFlowAnalyzer::visit(_e);
+
+	if (!builtin || !builtin->instruction)
+		return;
+
+	switch (*builtin->instruction)
+	{
+	case Instruction::LT:
+	case Instruction::GT:
+	case Instruction::SLT:
+	case Instruction::SGT:
+	case Instruction::EQ:
+	case Instruction::ISZERO:
+	{
+		Range result = range(_e);
+		if (result.isConstant() && movable(_e))
+			_e = Literal{locationOf(_e), LiteralKind::Number, YulString{util::formatNumber(result.min)}, {}};
+		break;
+	}
+	case Instruction::AND:
+		for (size_t i = 0; i < 2; ++i)
+		{
+			Range mask = range(call->arguments[i]);
+			if (
+				mask.isConstant() &&
+				(mask.min & (mask.min + 1)) == 0 &&
+				range(call->arguments[1 - i]).max <= mask.min &&
+				movable(call->arguments[i])
+			)
+			{
+				Expression value = move(call->arguments[1 - i]);
+				_e = move(value);
+				return;
+			}
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+RangeSimplifier::Range RangeSimplifier::range(Expression const& _expression) const
+{
+	if (auto const* literal = get_if<Literal>(&_expression))
+	{
+		u256 value = valueOfLiteral(*literal);
+		return Range{value, value};
+	}
+	if (auto const* identifier = get_if<Identifier>(&_expression))
+		return range(identifier->name);
+
+	FunctionCall const& call = std::get<FunctionCall>(_expression);
+	BuiltinFunctionForEVM const* builtin = dynamic_cast<EVMDialect const&>(m_dialect).builtin(call.functionName.name);
+	if (!builtin || !builtin->instruction || builtin->literalArguments)
+		return Range{};
+
+	vector<Range> arguments;
+	for (Expression const& argument: call.arguments)
+		arguments.emplace_back(range(argument));
+
+	u256 const maxValue = Range{}.max;
+	u256 const maxSignedValue = maxValue >> 1;
+	auto lessThan = [](Range const& _a, Range const& _b) {
+		if (_a.max < _b.min)
+			return Range{1, 1};
+		if (_a.min >= _b.max)
+			return Range{0, 0};
+		return Range{0, 1};
+	};
+	auto nonNegative = [&](Range const& _a) { return _a.max <= maxSignedValue; };
+
+	switch (*builtin->instruction)
+	{
+	case Instruction::ADD:
+		if (bigint(arguments[0].max) + arguments[1].max <= maxValue)
+			return Range{arguments[0].min + arguments[1].min, arguments[0].max + arguments[1].max};
+		break;
+	case Instruction::SUB:
+		if (arguments[0].min >= arguments[1].max)
+			return Range{arguments[0].min - arguments[1].max, arguments[0].max - arguments[1].min};
+		break;
+	case Instruction::MUL:
+		if (bigint(arguments[0].max) * arguments[1].max <= maxValue)
+			return Range{arguments[0].min * arguments[1].min, arguments[0].max * arguments[1].max};
+		break;
+	case Instruction::DIV:
+		// Division by zero results in zero.
+		if (arguments[1].min > 0)
+			return Range{arguments[0].min / arguments[1].max, arguments[0].max / arguments[1].min};
+		return Range{0, arguments[0].max};
+	case Instruction::MOD:
+		if (arguments[1].max == 0)
+			return Range{0, 0};
+		return Range{0, min(arguments[0].max, arguments[1].max - 1)};
+	case Instruction::AND:
+		return Range{0, min(arguments[0].max, arguments[1].max)};
+	case Instruction::NOT:
+		return Range{~arguments[0].max, ~arguments[0].min};
+	case Instruction::SHR:
+		return Range{
+			arguments[0].max >= 256 ? 0 : arguments[1].min >> unsigned(arguments[0].max),
+			arguments[0].min >= 256 ? 0 : arguments[1].max >> unsigned(arguments[0].min)
+		};
+	case Instruction::BYTE:
+		return Range{0, 0xff};
+	case Instruction::LT:
+		return lessThan(arguments[0], arguments[1]);
+	case Instruction::GT:
+		return lessThan(arguments[1], arguments[0]);
+	case Instruction::SLT:
+		if (nonNegative(arguments[0]) && nonNegative(arguments[1]))
+			return lessThan(arguments[0], arguments[1]);
+		return Range{0, 1};
+	case Instruction::SGT:
+		if (nonNegative(arguments[0]) && nonNegative(arguments[1]))
+			return lessThan(arguments[1], arguments[0]);
+		return Range{0, 1};
+	case Instruction::EQ:
+		if (arguments[0].max < arguments[1].min || arguments[1].max < arguments[0].min)
+			return Range{0, 0};
+		if (arguments[0].isConstant() && arguments[1].isConstant())
+			return Range{1, 1};
+		return Range{0, 1};
+	case Instruction::ISZERO:
+		if (arguments[0].min > 0)
+			return Range{0, 0};
+		if (arguments[0].max == 0)
+			return Range{1, 1};
+		return Range{0, 1};
+	default:
+		break;
+	}
+	return Range{};
+}
+
+RangeSimplifier::Range RangeSimplifier::range(YulString _variable) const
+{
+	if (Range const* knownRange = util::valueOrNullptr(m_ranges, _variable))
+		return *knownRange;
+	return Range{};
+}
+
+void RangeSimplifier::setRange(YulString _variable, Range const& _range)
+{
+	if (_range.min == 0 && _range.max == Range{}.max)
+		m_ranges.erase(_variable);
+	else
+		m_ranges[_variable] = _range;
+}
+
+void RangeSimplifier::learn(Ranges& _ranges, Expression const& _condition, bool _value, size_t _depth) const
+{
+	if (_depth > maxConditionDepth)
+		return;
+
+	if (auto const* identifier = get_if<Identifier>(&_condition))
+	{
+		restrict(_ranges, _condition, _value ? Range{1, Range{}.max} : Range{0, 0});
+		if (AssignedValue const* value = util::valueOrNullptr(m_value, identifier->name))
+			if (value->value)
+				learn(_ranges, *value->value, _value, _depth + 1);
+		return;
+	}
+
+	FunctionCall const* call = get_if<FunctionCall>(&_condition);
+	if (!call)
+		return;
+	BuiltinFunctionForEVM const* builtin = dynamic_cast<EVMDialect const&>(m_dialect).builtin(call->functionName.name);
+	if (!builtin || !builtin->instruction)
+		return;
+
+	vector<Expression> const& arguments = call->arguments;
+	switch (*builtin->instruction)
+	{
+	case Instruction::ISZERO:
+		learn(_ranges, arguments[0], !_value, _depth + 1);
+		break;
+	case Instruction::LT:
+		learnLessThan(_ranges, arguments[0], arguments[1], _value);
+		break;
+	case Instruction::GT:
+		learnLessThan(_ranges, arguments[1], arguments[0], _value);
+		break;
+	case Instruction::EQ:
+		if (_value)
+		{
+			restrict(_ranges, arguments[0], range(arguments[1]));
+			restrict(_ranges, arguments[1], range(arguments[0]));
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void RangeSimplifier::learnLessThan(
+	Ranges& _ranges,
+	Expression const& _a,
+	Expression const& _b,
+	bool _value
+) const
+{
+	Range a = range(_a);
+	Range b = range(_b);
+	if (_value)
+	{
+		// The code is unreachable in the other cases, so we do not learn anything.
+		if (b.max > 0)
+			restrict(_ranges, _a, Range{0, b.max - 1});
+		if (a.min < Range{}.max)
+			restrict(_ranges, _b, Range{a.min + 1, Range{}.max});
+	}
+	else
+	{
+		restrict(_ranges, _a, Range{b.min, Range{}.max});
+		restrict(_ranges, _b, Range{0, a.max});
+	}
+}
+
+void RangeSimplifier::restrict(Ranges& _ranges, Expression const& _variable, Range const& _range)
+{
+	auto const* identifier = get_if<Identifier>(&_variable);
+	if (!identifier)
+		return;
+
+	Range current;
+	if (Range const* knownRange = util::valueOrNullptr(_ranges, identifier->name))
+		current = *knownRange;
+	Range restricted{max(current.min, _range.min), min(current.max, _range.max)};
+	// An empty range means that the code is unreachable, which we do not exploit.
+	if (restricted.min <= restricted.max)
+		_ranges[identifier->name] = restricted;
+}
+
+RangeSimplifier::Ranges RangeSimplifier::join(Ranges const& _a, Ranges const& _b)
+{
+	Ranges ret;
+	for (auto const& [variable, range]: _a)
+		if (Range const* otherRange = util::valueOrNullptr(_b, variable))
+			ret[variable] = Range{min(range.min, otherRange->min), max(range.max, otherRange->max)};
+	return ret;
+}
+
+bool RangeSimplifier::movable(Expression const& _expression) const
+{
+	return SideEffectsCollector{m_dialect, _expression, &m_functionSideEffects}.movable();
+}
@@ -0,0 +1,129 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that replaces comparisons and masks by their value
+ * if it follows from the ranges of the values involved.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <libsolutil/Common.h>
+
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+struct SideEffects;
+
+/**
+ * Optimisation stage that tracks an unsigned range of possible values for each variable
+ * and uses it to replace comparisons (``lt``, ``gt``, ``slt``, ``sgt``, ``eq`` and ``iszero``)
+ * by constants and masks ``and(x, 2**k - 1)`` by ``x`` if the outcome does not depend on
+ * the actual values.
+ *
+ * The range of a variable is determined from the value assigned to it, using literals,
+ * masks and simple arithmetic that is known not to overflow. Ranges are further restricted
+ * by the conditions of ``if`` statements and ``for`` loops inside their bodies,
+ * by ``switch`` cases, and, after an ``if`` statement whose body always terminates
+ * (e.g. ``if gt(x, 10) { revert(0, 0) }``) or leaves the loop, by the negated condition.
+ *
+ * This removes overflow checks that can never fail, for example the
+ * check of the increment of a loop variable that is bounded by the loop condition:
+ *
+ * for { let i := 0 } lt(i, n) { if gt(i, sub(not(0), 1)) { revert(0, 0) } i := add(i, 1) } { }
+ *
+ * is transformed into
+ *
+ * for { let i := 0 } lt(i, n) { if 0 { revert(0, 0) } i := add(i, 1) } { }
+ *
+ * Works best with SSA form and if the condition of for loops is moved into the body.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class RangeSimplifier: public DataFlowAnalyzer
+{
+public:
+	static constexpr char const* name{"RangeSimplifier"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(VariableDeclaration& _varDecl) override;
+	void operator()(Assignment& _assignment) override;
+	void operator()(If& _if) override;
+	void operator()(Switch& _switch) override;
+	void operator()(FunctionDefinition& _function) override;
+	void operator()(ForLoop& _for) override;
+	void operator()(Continue& _continue) override;
+	void operator()(Block& _block) override;
+
+private:
+	/// Inclusive range of unsigned values.
+	struct Range
+	{
+		u256 min = 0;
+		u256 max = ~u256(0);
+
+		bool isConstant() const { return min == max; }
+	};
+	using Ranges = std::map<YulString, Range>;
+
+	/// Ranges at the entry of the post block of a for loop, joined from the end of the body
+	/// and all ``continue`` statements.
+	struct Loop
+	{
+		Block const* body = nullptr;
+		Block const* post = nullptr;
+		std::optional<Ranges> postRanges;
+	};
+
+	RangeSimplifier(Dialect const& _dialect, std::map<YulString, SideEffects> _functionSideEffects):
+		DataFlowAnalyzer(_dialect, std::move(_functionSideEffects))
+	{}
+
+	using ASTModifier::visit;
+	void visit(Expression& _e) override;
+
+	/// @returns the range of values @a _expression can evaluate to.
+	Range range(Expression const& _expression) const;
+	Range range(YulString _variable) const;
+	/// Sets the range of @a _variable, or removes it if nothing is known.
+	void setRange(YulString _variable, Range const& _range);
+	/// Restricts the ranges of the variables in @a _ranges under the assumption that
+	/// @a _condition evaluates to a nonzero value (or zero if @a _value is false).
+	void learn(Ranges& _ranges, Expression const& _condition, bool _value, size_t _depth = 0) const;
+	/// Helper for ``learn`` for the condition ``lt(_a, _b)``.
+	void learnLessThan(Ranges& _ranges, Expression const& _a, Expression const& _b, bool _value) const;
+	static void restrict(Ranges& _ranges, Expression const& _variable, Range const& _range);
+	/// @returns the ranges that are valid in both @a _a and @a _b.
+	static Ranges join(Ranges const& _a, Ranges const& _b);
+
+	bool movable(Expression const& _expression) const;
+
+	Ranges m_ranges;
+	/// Ranges to use when entering the given blocks.
+	std::map<Block const*, Ranges> m_blockRanges;
+	std::vector<Loop> m_loops;
+};
+
+}
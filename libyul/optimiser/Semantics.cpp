@@ -20,10 +20,12 @@
 
 #include <libyul/optimiser/Semantics.h>
 
+#include <libyul/optimiser/NameCollector.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AsmData.h>
 #include <libyul/Dialect.h>
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/Utilities.h>
 
 #include <libevmasm/SemanticInformation.h>
 
@@ -154,6 +156,180 @@ map<YulString, SideEffects> SideEffectsPropagator::sideEffects(
 	return ret;
 }
 
+namespace
+{
+
+/**
+ * Collects the locations each user-defined function writes to directly
+ * and the calls it makes to other user-defined functions.
+ */
+class DirectWritesCollector: public ASTWalker
+{
+public:
+	struct FunctionInfo
+	{
+		/// Parameters that are never re-assigned, with their index.
+		map<YulString, size_t> parameters;
+		/// Variables that are never re-assigned and whose value is a literal.
+		map<YulString, u256> constants;
+		set<YulString> assignedVariables;
+		FunctionWrites writes;
+		vector<FunctionCall const*> calls;
+	};
+
+	explicit DirectWritesCollector(Dialect const& _dialect):
+		m_dialect(_dialect),
+		m_evmDialect(dynamic_cast<EVMDialect const*>(&_dialect))
+	{}
+
+	using ASTWalker::operator();
+	void operator()(FunctionDefinition const& _function) override
+	{
+		Assignments assignments;
+		assignments(_function.body);
+
+		FunctionInfo* outerFunction = m_currentFunction;
+		m_currentFunction = &m_functions[_function.name];
+		m_currentFunction->assignedVariables = assignments.names();
+		for (size_t i = 0; i < _function.parameters.size(); ++i)
+			if (!assignments.names().count(_function.parameters[i].name))
+				m_currentFunction->parameters[_function.parameters[i].name] = i;
+		ASTWalker::operator()(_function);
+		m_currentFunction = outerFunction;
+	}
+
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		ASTWalker::operator()(_varDecl);
+		if (!m_currentFunction || _varDecl.variables.size() != 1 || !_varDecl.value)
+			return;
+		YulString name = _varDecl.variables.front().name;
+		if (auto const* literal = get_if<Literal>(_varDecl.value.get()))
+			if (!m_currentFunction->assignedVariables.count(name))
+				m_currentFunction->constants[name] = valueOfLiteral(*literal);
+	}
+
+	void operator()(FunctionCall const& _functionCall) override
+	{
+		ASTWalker::operator()(_functionCall);
+		if (!m_currentFunction)
+			return;
+
+		FunctionWrites& writes = m_currentFunction->writes;
+		BuiltinFunction const* builtin = m_dialect.builtin(_functionCall.functionName.name);
+		if (!builtin)
+		{
+			m_currentFunction->calls.emplace_back(&_functionCall);
+			return;
+		}
+
+		if (m_evmDialect)
+			if (auto instruction = m_evmDialect->builtin(_functionCall.functionName.name)->instruction)
+			{
+				if (*instruction == evmasm::Instruction::SSTORE)
+				{
+					addLocation(writes.storage, _functionCall.arguments.front(), *m_currentFunction);
+					return;
+				}
+				if (
+					*instruction == evmasm::Instruction::MSTORE ||
+					*instruction == evmasm::Instruction::MSTORE8
+				)
+				{
+					addLocation(writes.memory, _functionCall.arguments.front(), *m_currentFunction);
+					return;
+				}
+			}
+		if (builtin->sideEffects.invalidatesStorage)
+			writes.storage.unknown = true;
+		if (builtin->sideEffects.invalidatesMemory)
+			writes.memory.unknown = true;
+	}
+
+	/// Adds the location given by the expression @a _key to @a _locations.
+	static void addLocation(
+		WrittenLocations& _locations,
+		Expression const& _key,
+		FunctionInfo const& _function
+	)
+	{
+		if (auto const* literal = get_if<Literal>(&_key))
+			_locations.literals.insert(valueOfLiteral(*literal));
+		else if (auto const* identifier = get_if<Identifier>(&_key); identifier && _function.parameters.count(identifier->name))
+			_locations.parameters.insert(_function.parameters.at(identifier->name));
+		else if (identifier && _function.constants.count(identifier->name))
+			_locations.literals.insert(_function.constants.at(identifier->name));
+		else
+			_locations.unknown = true;
+	}
+
+	map<YulString, FunctionInfo> m_functions;
+
+private:
+	Dialect const& m_dialect;
+	EVMDialect const* m_evmDialect = nullptr;
+	FunctionInfo* m_currentFunction = nullptr;
+};
+
+/// Adds the locations written by a callee to the locations of the caller,
+/// translating the parameters of the callee to the arguments of the call.
+void addCalleeLocations(
+	WrittenLocations& _locations,
+	WrittenLocations const& _calleeLocations,
+	vector<Expression> const& _arguments,
+	DirectWritesCollector::FunctionInfo const& _function
+)
+{
+	if (_calleeLocations.unknown)
+		_locations.unknown = true;
+	_locations.literals.insert(_calleeLocations.literals.begin(), _calleeLocations.literals.end());
+	for (size_t parameter: _calleeLocations.parameters)
+		DirectWritesCollector::addLocation(_locations, _arguments.at(parameter), _function);
+}
+
+}
+
+map<YulString, FunctionWrites> WrittenLocationsPropagator::writtenLocations(
+	Dialect const& _dialect,
+	Block const& _ast
+)
+{
+	DirectWritesCollector collector{_dialect};
+	collector(_ast);
+	map<YulString, DirectWritesCollector::FunctionInfo>& functions = collector.m_functions;
+
+	// Propagate the locations along the calls until nothing changes anymore.
+	// This terminates because the sets of locations only grow and are bounded
+	// by the literals and parameters in the code.
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (auto& [name, info]: functions)
+			for (FunctionCall const* call: info.calls)
+			{
+				FunctionWrites writes = info.writes;
+				if (auto callee = functions.find(call->functionName.name); callee != functions.end())
+				{
+					addCalleeLocations(writes.storage, callee->second.writes.storage, call->arguments, info);
+					addCalleeLocations(writes.memory, callee->second.writes.memory, call->arguments, info);
+				}
+				else
+					writes.storage.unknown = writes.memory.unknown = true;
+				if (writes.storage != info.writes.storage || writes.memory != info.writes.memory)
+				{
+					info.writes = move(writes);
+					changed = true;
+				}
+			}
+	}
+
+	map<YulString, FunctionWrites> ret;
+	for (auto& [name, info]: functions)
+		ret[name] = move(info.writes);
+	return ret;
+}
+
 MovableChecker::MovableChecker(Dialect const& _dialect, Expression const& _expression):
 	MovableChecker(_dialect)
 {
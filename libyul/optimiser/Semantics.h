@@ -25,7 +25,11 @@
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/AsmData.h>
 
+#include <libsolutil/Common.h>
+
+#include <map>
 #include <set>
+#include <tuple>
 
 namespace solidity::yul
 {
@@ -90,6 +94,50 @@ public:
 	);
 };
 
+/**
+ * Storage slots or memory locations a user-defined function may write to.
+ * A location is either a literal or a parameter of the function that is never re-assigned.
+ * Memory locations refer to the 32 bytes starting at the location.
+ */
+struct WrittenLocations
+{
+	/// If true, the function may write to arbitrary locations.
+	bool unknown = false;
+	std::set<u256> literals;
+	/// Indices of the parameters whose value is written to.
+	std::set<size_t> parameters;
+
+	bool operator==(WrittenLocations const& _other) const
+	{
+		return std::tie(unknown, literals, parameters) ==
+			std::tie(_other.unknown, _other.literals, _other.parameters);
+	}
+	bool operator!=(WrittenLocations const& _other) const { return !(*this == _other); }
+};
+
+struct FunctionWrites
+{
+	WrittenLocations storage;
+	WrittenLocations memory;
+};
+
+/**
+ * This class can be used to determine the storage slots and memory locations
+ * user-defined functions may write to, including the writes of the functions they call.
+ *
+ * Only ``sstore``, ``mstore`` and ``mstore8`` are tracked whose location is a literal,
+ * a variable that is assigned a literal or a parameter, where the variables are never
+ * re-assigned. Any other builtin that invalidates storage or memory makes the
+ * respective locations unknown.
+ *
+ * Prerequisite: Disambiguator
+ */
+class WrittenLocationsPropagator
+{
+public:
+	static std::map<YulString, FunctionWrites> writtenLocations(Dialect const& _dialect, Block const& _ast);
+};
+
 /**
  * Class that can be used to find out if certain code contains the MSize instruction.
  *
@@ -0,0 +1,410 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that replaces multiplications of loop induction variables
+ * by additional induction variables.
+ */
+
+#include <libyul/optimiser/StrengthReducer.h>
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmData.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <functional>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/**
+ * Calls a function on each expression in post-order, which may replace the expression.
+ */
+class ExpressionCallback: public ASTModifier
+{
+public:
+	explicit ExpressionCallback(function<void(Expression&)> _callback): m_callback(move(_callback)) {}
+
+	using ASTModifier::visit;
+	void visit(Expression& _expression) override
+	{
+		ASTModifier::visit(_expression);
+		m_callback(_expression);
+	}
+
+private:
+	function<void(Expression&)> m_callback;
+};
+
+Expression numberLiteral(langutil::SourceLocation const& _location, u256 const& _value)
+{
+	return Literal{_location, LiteralKind::Number, YulString{util::formatNumber(_value)}, {}};
+}
+
+Expression builtinCall(langutil::SourceLocation const& _location, YulString _name, Expression _a, Expression _b)
+{
+	return FunctionCall{_location, Identifier{_location, _name}, util::make_vector<Expression>(move(_a), move(_b))};
+}
+
+template <class Key>
+size_t countOf(map<Key, size_t> const& _counts, Key const& _key)
+{
+	auto it = _counts.find(_key);
+	return it == _counts.end() ? 0 : it->second;
+}
+
+/// @returns the variables assigned or declared by @a _statement if it is
+/// a variable declaration or an assignment.
+vector<YulString> targets(Statement const& _statement)
+{
+	vector<YulString> names;
+	if (auto const* varDecl = get_if<VariableDeclaration>(&_statement))
+		for (auto const& variable: varDecl->variables)
+			names.emplace_back(variable.name);
+	else if (auto const* assignment = get_if<Assignment>(&_statement))
+		for (auto const& variable: assignment->variableNames)
+			names.emplace_back(variable.name);
+	return names;
+}
+
+}
+
+void StrengthReducer::run(OptimiserStepContext& _context, Block& _ast)
+{
+	if (!dynamic_cast<EVMDialect const*>(&_context.dialect))
+		return;
+
+	StrengthReducer{
+		_context.dialect,
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
+		_context.dispenser,
+		ReferencesCounter::countReferences(_ast, ReferencesCounter::OnlyVariables)
+	}(_ast);
+}
+
+void StrengthReducer::visit(Statement& _statement)
+{
+	if (ForLoop* loop = get_if<ForLoop>(&_statement))
+	{
+		vector<Statement> declarations = reduce(*loop);
+		if (!declarations.empty())
+		{
+			Block block{loop->location, move(declarations)};
+			block.statements.emplace_back(move(*loop));
+			_statement = move(block);
+		}
+	}
+
+	DataFlowAnalyzer::visit(_statement);
+}
+
+vector<Statement> StrengthReducer::reduce(ForLoop& _loop)
+{
+	if (!_loop.pre.statements.empty())
+		return {};
+
+	Assignments assignedInBody;
+	assignedInBody(_loop.body);
+	Assignments assignedInLoop;
+	assignedInLoop(_loop.body);
+	assignedInLoop(_loop.post);
+	m_assignedInLoop = assignedInLoop.names();
+
+	optional<map<YulString, Affine>> postValues = postBlockValues(_loop);
+	if (!postValues)
+		return {};
+
+	map<YulString, u256> inductionVariables;
+	for (auto const& [variable, value]: *postValues)
+		if (value.base == variable && value.offset != 0 && !assignedInBody.names().count(variable))
+			inductionVariables[variable] = value.offset;
+	if (inductionVariables.empty())
+		return {};
+
+	map<pair<YulString, u256>, size_t> multiplicationsInCondition;
+	map<pair<YulString, u256>, size_t> multiplicationsInBody;
+	map<YulString, set<u256>> factors;
+	auto counter = [&](map<pair<YulString, u256>, size_t>& _counts) {
+		return ExpressionCallback{[&](Expression& _expression) {
+			if (auto match = multiplication(_expression, inductionVariables))
+			{
+				++_counts[*match];
+				factors[match->first].insert(match->second);
+			}
+		}};
+	};
+	counter(multiplicationsInCondition).visit(*_loop.condition);
+	counter(multiplicationsInBody)(_loop.body);
+
+	map<YulString, size_t> referencesInCondition =
+		ReferencesCounter::countReferences(*_loop.condition, ReferencesCounter::OnlyVariables);
+	map<YulString, size_t> referencesInBody =
+		ReferencesCounter::countReferences(_loop.body, ReferencesCounter::OnlyVariables);
+	map<YulString, size_t> referencesInPost =
+		ReferencesCounter::countReferences(_loop.post, ReferencesCounter::OnlyVariables);
+	set<YulString> declaredInPost = NameCollector{_loop.post}.names();
+
+	vector<Statement> declarations;
+	vector<Statement> updates;
+	map<pair<YulString, u256>, YulString> replacements;
+	set<YulString> removedVariables;
+	unique_ptr<Expression> newCondition;
+	langutil::SourceLocation const& location = _loop.location;
+
+	for (auto const& [variable, variableFactors]: factors)
+	{
+		u256 const& step = inductionVariables.at(variable);
+		optional<u256> startValue = m_knowledgeBase.valueIfKnownConstant(variable);
+		for (u256 const& factor: variableFactors)
+		{
+			pair<YulString, u256> key{variable, factor};
+			size_t inCondition = countOf(multiplicationsInCondition, key);
+			size_t inBody = countOf(multiplicationsInBody, key);
+
+			// Check whether the condition can be expressed using the new variable.
+			optional<u256> bound;
+			bool lessThan = true;
+			if (auto const* call = get_if<FunctionCall>(_loop.condition.get()))
+				if (
+					startValue &&
+					!newCondition &&
+					call->arguments.size() == 2 &&
+					(call->functionName.name == "lt"_yulstring || call->functionName.name == "gt"_yulstring)
+				)
+				{
+					lessThan = call->functionName.name == "lt"_yulstring;
+					Expression const& variableArgument = call->arguments.at(lessThan ? 0 : 1);
+					if (
+						holds_alternative<Identifier>(variableArgument) &&
+						std::get<Identifier>(variableArgument).name == variable
+					)
+						bound = loopConstant(call->arguments.at(lessThan ? 1 : 0));
+				}
+			if (bound)
+			{
+				// All values the variable takes before the loop is left are at most ``upper``,
+				// so the comparison does not change if both sides are multiplied by the factor.
+				bigint const maxValue = bigint(u256(-1));
+				bigint upper = max(
+					bigint(*startValue),
+					*bound == 0 ? bigint(0) : bigint(*bound) - 1 + bigint(step)
+				);
+				if (upper > maxValue || upper * bigint(factor) > maxValue)
+					bound.reset();
+			}
+
+			// Check whether the original variable is not needed anymore.
+			size_t conditionReferences = countOf(referencesInCondition, variable);
+			bool replacesVariable =
+				variableFactors.size() == 1 &&
+				(conditionReferences == inCondition || (bound && conditionReferences == 1)) &&
+				countOf(referencesInBody, variable) == inBody &&
+				m_references[variable] ==
+					conditionReferences +
+					countOf(referencesInBody, variable) +
+					countOf(referencesInPost, variable);
+			set<YulString> derived{variable};
+			for (auto const& [name, value]: *postValues)
+				if (value.base == variable && declaredInPost.count(name))
+					derived.insert(name);
+			if (replacesVariable)
+				for (Statement const& statement: _loop.post.statements)
+				{
+					vector<YulString> assigned = targets(statement);
+					if (!assigned.empty() && derived.count(assigned.front()))
+						continue;
+					ReferencesCounter references{ReferencesCounter::OnlyVariables};
+					references.visit(statement);
+					for (auto const& reference: references.references())
+						if (derived.count(reference.first))
+							replacesVariable = false;
+				}
+
+			if (!replacesVariable && inCondition + inBody < 2)
+				continue;
+
+			YulString newVariable = m_nameDispenser.newName(variable);
+			Expression initialValue = startValue ?
+				numberLiteral(location, *startValue * factor) :
+				builtinCall(location, "mul"_yulstring, Identifier{location, variable}, numberLiteral(location, factor));
+			if (!startValue)
+				++m_references[variable];
+			declarations.emplace_back(VariableDeclaration{
+				location,
+				{TypedName{location, newVariable, {}}},
+				make_unique<Expression>(move(initialValue))
+			});
+			updates.emplace_back(Assignment{
+				location,
+				{Identifier{location, newVariable}},
+				make_unique<Expression>(builtinCall(
+					location,
+					"add"_yulstring,
+					Identifier{location, newVariable},
+					numberLiteral(location, step * factor)
+				))
+			});
+			replacements[key] = newVariable;
+
+			if (replacesVariable)
+			{
+				removedVariables.insert(derived.begin(), derived.end());
+				if (conditionReferences != inCondition)
+				{
+					Expression scaledBound = numberLiteral(location, *bound * factor);
+					newCondition = make_unique<Expression>(lessThan ?
+						builtinCall(location, "lt"_yulstring, Identifier{location, newVariable}, move(scaledBound)) :
+						builtinCall(location, "gt"_yulstring, move(scaledBound), Identifier{location, newVariable})
+					);
+				}
+			}
+		}
+	}
+
+	if (declarations.empty())
+		return {};
+
+	ExpressionCallback replacer{[&](Expression& _expression) {
+		if (auto match = multiplication(_expression, inductionVariables))
+			if (YulString const* newVariable = util::valueOrNullptr(replacements, *match))
+				_expression = Identifier{locationOf(_expression), *newVariable};
+	}};
+	replacer.visit(*_loop.condition);
+	replacer(_loop.body);
+	if (newCondition)
+		_loop.condition = move(newCondition);
+
+	util::iterateReplacing(_loop.post.statements, [&](Statement& _statement) -> optional<vector<Statement>> {
+		vector<YulString> assigned = targets(_statement);
+		if (!assigned.empty() && removedVariables.count(assigned.front()))
+			return vector<Statement>{};
+		return nullopt;
+	});
+	for (Statement& update: updates)
+		_loop.post.statements.emplace_back(move(update));
+
+	return declarations;
+}
+
+optional<map<YulString, StrengthReducer::Affine>> StrengthReducer::postBlockValues(ForLoop const& _loop)
+{
+	map<YulString, Affine> values;
+	Assignments assignedInPost;
+	assignedInPost(_loop.post);
+	for (YulString variable: assignedInPost.names())
+		values[variable] = Affine{variable, 0};
+
+	for (Statement const& statement: _loop.post.statements)
+	{
+		Expression const* value = nullptr;
+		if (auto const* varDecl = get_if<VariableDeclaration>(&statement))
+			value = varDecl->value.get();
+		else if (auto const* assignment = get_if<Assignment>(&statement))
+			value = assignment->value.get();
+		else if (holds_alternative<ExpressionStatement>(statement))
+			continue;
+		else
+			return nullopt;
+
+		vector<YulString> assigned = targets(statement);
+		optional<Affine> result;
+		if (assigned.size() == 1)
+			result = value ? affine(*value, values) : Affine{{}, 0};
+		for (YulString variable: assigned)
+			values.erase(variable);
+		if (result)
+			values[assigned.front()] = *result;
+	}
+	return values;
+}
+
+optional<StrengthReducer::Affine> StrengthReducer::affine(
+	Expression const& _expression,
+	map<YulString, Affine> const& _values
+)
+{
+	if (auto const* identifier = get_if<Identifier>(&_expression))
+		if (Affine const* value = util::valueOrNullptr(_values, identifier->name))
+			return *value;
+
+	if (auto const* call = get_if<FunctionCall>(&_expression))
+		if (
+			call->arguments.size() == 2 &&
+			(call->functionName.name == "add"_yulstring || call->functionName.name == "sub"_yulstring) &&
+			m_dialect.builtin(call->functionName.name)
+		)
+		{
+			optional<Affine> a = affine(call->arguments.at(0), _values);
+			optional<Affine> b = affine(call->arguments.at(1), _values);
+			if (!a || !b || b->base)
+			{
+				// Only the first operand of ``sub`` can be based on an induction variable.
+				if (a && b && !a->base && call->functionName.name == "add"_yulstring)
+					return Affine{b->base, a->offset + b->offset};
+				return nullopt;
+			}
+			else if (call->functionName.name == "add"_yulstring)
+				return Affine{a->base, a->offset + b->offset};
+			else
+				return Affine{a->base, a->offset - b->offset};
+		}
+
+	if (optional<u256> value = loopConstant(_expression))
+		return Affine{{}, *value};
+	return nullopt;
+}
+
+optional<u256> StrengthReducer::loopConstant(Expression const& _expression)
+{
+	if (holds_alternative<Literal>(_expression))
+		return valueOfLiteral(std::get<Literal>(_expression));
+	else if (auto const* identifier = get_if<Identifier>(&_expression))
+		if (!m_assignedInLoop.count(identifier->name))
+			return m_knowledgeBase.valueIfKnownConstant(identifier->name);
+	return nullopt;
+}
+
+optional<pair<YulString, u256>> StrengthReducer::multiplication(
+	Expression const& _expression,
+	map<YulString, u256> const& _inductionVariables
+)
+{
+	auto const* call = get_if<FunctionCall>(&_expression);
+	if (
+		!call ||
+		call->functionName.name != "mul"_yulstring ||
+		call->arguments.size() != 2 ||
+		!m_dialect.builtin(call->functionName.name)
+	)
+		return nullopt;
+
+	for (size_t i = 0; i < 2; ++i)
+		if (auto const* identifier = get_if<Identifier>(&call->arguments.at(i)))
+			if (_inductionVariables.count(identifier->name))
+				if (optional<u256> factor = loopConstant(call->arguments.at(1 - i)); factor && *factor > 1)
+					return make_pair(identifier->name, *factor);
+	return nullopt;
+}
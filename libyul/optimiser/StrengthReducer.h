@@ -0,0 +1,122 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that replaces multiplications of loop induction variables
+ * by additional induction variables.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <libsolutil/Common.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace solidity::yul
+{
+
+class NameDispenser;
+struct SideEffects;
+
+/**
+ * Optimisation stage that replaces multiplications of induction variables of for loops
+ * by constants with new induction variables that are updated using addition.
+ *
+ * An induction variable is a variable declared outside of the loop that is not assigned in
+ * the body and increased by a constant in the post block (possibly through variables declared
+ * in the post block, as it is the case in SSA form).
+ *
+ * let i := 0
+ * for { } lt(i, 10) { i := add(i, 1) } { mstore(mul(i, 32), 7) }
+ *
+ * is transformed into
+ *
+ * let i := 0
+ * { let i_1 := 0 for { } lt(i_1, 320) { i_1 := add(i_1, 32) } { mstore(i_1, 7) } }
+ *
+ * The condition ``lt(i, n)`` (or ``gt(n, i)``) is rewritten in terms of the new variable if ``n``
+ * and the value of ``i`` before the loop are known constants and no overflow can occur. If the
+ * original induction variable is not used anymore after that, its updates are removed.
+ * Since maintaining the new variable is not cheaper than a single multiplication,
+ * a multiplication is only replaced if this removes the original variable or
+ * if it occurs at least twice.
+ *
+ * Only runs for EVM dialects.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class StrengthReducer: public DataFlowAnalyzer
+{
+public:
+	static constexpr char const* name{"StrengthReducer"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using ASTModifier::visit;
+	void visit(Statement& _statement) override;
+
+private:
+	/// Value of a variable in the post block of a loop, relative to the value the
+	/// induction variable ``base`` has at the start of the post block.
+	struct Affine
+	{
+		std::optional<YulString> base;
+		u256 offset;
+	};
+
+	StrengthReducer(
+		Dialect const& _dialect,
+		std::map<YulString, SideEffects> _functionSideEffects,
+		NameDispenser& _nameDispenser,
+		std::map<YulString, size_t> _references
+	):
+		DataFlowAnalyzer(_dialect, std::move(_functionSideEffects)),
+		m_nameDispenser(_nameDispenser),
+		m_references(std::move(_references))
+	{}
+
+	/// Reduces the multiplications in @a _loop and @returns the declarations
+	/// of the new variables, which have to be inserted in front of the loop.
+	std::vector<Statement> reduce(ForLoop& _loop);
+
+	/// @returns the values of all variables assigned in the post block of @a _loop,
+	/// as far as they are affine in one of the variables assigned in the post block,
+	/// or nullopt if the post block contains other statements.
+	std::optional<std::map<YulString, Affine>> postBlockValues(ForLoop const& _loop);
+	std::optional<Affine> affine(Expression const& _expression, std::map<YulString, Affine> const& _values);
+
+	/// @returns the value of @a _expression if it is a constant that does not change inside the loop.
+	std::optional<u256> loopConstant(Expression const& _expression);
+	/// @returns the variable and the factor if @a _expression is a multiplication
+	/// of one of the @a _inductionVariables by a constant.
+	std::optional<std::pair<YulString, u256>> multiplication(
+		Expression const& _expression,
+		std::map<YulString, u256> const& _inductionVariables
+	);
+
+	NameDispenser& m_nameDispenser;
+	/// Number of references to each variable in the whole code.
+	std::map<YulString, size_t> m_references;
+	/// Variables assigned inside the loop that is currently reduced.
+	std::set<YulString> m_assignedInLoop;
+};
+
+}
@@ -29,8 +29,10 @@
 #include <libyul/optimiser/ConditionalSimplifier.h>
 #include <libyul/optimiser/ConditionalUnsimplifier.h>
 #include <libyul/optimiser/DeadCodeEliminator.h>
+#include <libyul/optimiser/DeadStoreEliminator.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/FunctionHoister.h>
+#include <libyul/optimiser/FunctionSpecializer.h>
 #include <libyul/optimiser/EquivalentFunctionCombiner.h>
 #include <libyul/optimiser/ExpressionSplitter.h>
 #include <libyul/optimiser/ExpressionJoiner.h>
@@ -48,14 +50,18 @@
 #include <libyul/optimiser/SSAReverser.h>
 #include <libyul/optimiser/SSATransform.h>
 #include <libyul/optimiser/StackCompressor.h>
+#include <libyul/optimiser/StrengthReducer.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
 #include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/optimiser/RangeSimplifier.h>
 #include <libyul/optimiser/RedundantAssignEliminator.h>
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopUnroller.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/AsmData.h>
@@ -65,6 +71,7 @@
 #include <libyul/backends/wasm/WasmDialect.h>
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
+#include <libsolutil/AllocationStatistics.h>
 #include <libsolutil/CommonData.h>
 
 using namespace std;
@@ -76,9 +83,12 @@ void OptimiserSuite::run(
 	GasMeter const* _meter,
 	Object& _object,
 	bool _optimizeStackAllocation,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	StepObserver _observer
 )
 {
+	util::ScopedAllocationPhase allocationPhase("yulOptimizer");
+
 	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
 	reservedIdentifiers += _dialect.fixedFunctionNames();
 
@@ -89,7 +99,14 @@ void OptimiserSuite::run(
 	)(*_object.code));
 	Block& ast = *_object.code;
 
-	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast);
+	OptimiserSuite suite(
+		_dialect,
+		reservedIdentifiers,
+		Debug::None,
+		ast,
+		std::move(_observer),
+		_meter ? std::optional<size_t>(_meter->runs()) : std::nullopt
+	);
 
 	suite.runSequence({
 		VarDeclInitializer::name,
@@ -141,12 +158,15 @@ void OptimiserSuite::run(
 			// perform structural simplification
 			suite.runSequence({
 				CommonSubexpressionEliminator::name,
+				RangeSimplifier::name,
 				ConditionalSimplifier::name,
 				LiteralRematerialiser::name,
 				ConditionalUnsimplifier::name,
 				StructuralSimplifier::name,
 				LiteralRematerialiser::name,
 				ForLoopConditionOutOfBody::name,
+				LoopUnroller::name,
+				StrengthReducer::name,
 				ControlFlowSimplifier::name,
 				StructuralSimplifier::name,
 				ControlFlowSimplifier::name,
@@ -162,6 +182,7 @@ void OptimiserSuite::run(
 			// simplify again
 			suite.runSequence({
 				LoadResolver::name,
+				DeadStoreEliminator::name,
 				CommonSubexpressionEliminator::name,
 				UnusedPruner::name,
 				CircularReferencesPruner::name,
@@ -223,6 +244,7 @@ void OptimiserSuite::run(
 			suite.runSequence({
 				FunctionGrouper::name,
 				EquivalentFunctionCombiner::name,
+				FunctionSpecializer::name,
 				FullInliner::name,
 				BlockFlattener::name
 			}, ast);
@@ -299,6 +321,8 @@ void OptimiserSuite::run(
 		_optimizeStackAllocation,
 		stackCompressorMaxIterations
 	);
+	if (suite.m_observer)
+		suite.m_observer("StackCompressor", ast);
 	suite.runSequence({
 		BlockFlattener::name,
 		DeadCodeEliminator::name,
@@ -314,6 +338,8 @@ void OptimiserSuite::run(
 	{
 		yulAssert(_meter, "");
 		ConstantOptimiser{*dialect, *_meter}(ast);
+		if (suite.m_observer)
+			suite.m_observer("ConstantOptimiser", ast);
 	}
 	else if (dynamic_cast<WasmDialect const*>(&_dialect))
 	{
@@ -359,6 +385,7 @@ map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 			ConditionalUnsimplifier,
 			ControlFlowSimplifier,
 			DeadCodeEliminator,
+			DeadStoreEliminator,
 			EquivalentFunctionCombiner,
 			ExpressionInliner,
 			ExpressionJoiner,
@@ -370,13 +397,17 @@ map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 			FullInliner,
 			FunctionGrouper,
 			FunctionHoister,
+			FunctionSpecializer,
 			LiteralRematerialiser,
 			LoadResolver,
 			LoopInvariantCodeMotion,
+			LoopUnroller,
+			RangeSimplifier,
 			RedundantAssignEliminator,
 			Rematerialiser,
 			SSAReverser,
 			SSATransform,
+			StrengthReducer,
 			StructuralSimplifier,
 			UnusedPruner,
 			VarDeclInitializer
@@ -395,6 +426,7 @@ map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 		{ConditionalUnsimplifier::name,       'U'},
 		{ControlFlowSimplifier::name,         'n'},
 		{DeadCodeEliminator::name,            'D'},
+		{DeadStoreEliminator::name,           'S'},
 		{EquivalentFunctionCombiner::name,    'v'},
 		{ExpressionInliner::name,             'e'},
 		{ExpressionJoiner::name,              'j'},
@@ -406,13 +438,17 @@ map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 		{FullInliner::name,                   'i'},
 		{FunctionGrouper::name,               'g'},
 		{FunctionHoister::name,               'h'},
+		{FunctionSpecializer::name,           'F'},
 		{LiteralRematerialiser::name,         'T'},
 		{LoadResolver::name,                  'L'},
 		{LoopInvariantCodeMotion::name,       'M'},
+		{LoopUnroller::name,                  'w'},
+		{RangeSimplifier::name,               'R'},
 		{RedundantAssignEliminator::name,     'r'},
 		{Rematerialiser::name,                'm'},
 		{SSAReverser::name,                   'V'},
 		{SSATransform::name,                  'a'},
+		{StrengthReducer::name,               'k'},
 		{StructuralSimplifier::name,          't'},
 		{UnusedPruner::name,                  'u'},
 		{VarDeclInitializer::name,            'd'},
@@ -439,6 +475,8 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
 		allSteps().at(step)->run(m_context, _ast);
+		if (m_observer)
+			m_observer(step, _ast);
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
@@ -26,6 +26,8 @@
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <functional>
+#include <optional>
 #include <set>
 #include <string>
 #include <memory>
@@ -51,12 +53,16 @@ public:
 		PrintStep,
 		PrintChanges
 	};
+	/// Function that is called after each step with the name of the step and the resulting code.
+	using StepObserver = std::function<void(std::string const& _step, Block const& _ast)>;
+
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
 		Object& _object,
 		bool _optimizeStackAllocation,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		StepObserver _observer = {}
 	);
 
 	void runSequence(std::vector<std::string> const& _steps, Block& _ast);
@@ -70,16 +76,20 @@ private:
 		Dialect const& _dialect,
 		std::set<YulString> const& _externallyUsedIdentifiers,
 		Debug _debug,
-		Block& _ast
+		Block& _ast,
+		StepObserver _observer = {},
+		std::optional<size_t> _expectedExecutionsPerDeployment = std::nullopt
 	):
 		m_dispenser{_dialect, _ast, _externallyUsedIdentifiers},
-		m_context{_dialect, m_dispenser, _externallyUsedIdentifiers},
-		m_debug(_debug)
+		m_context{_dialect, m_dispenser, _externallyUsedIdentifiers, _expectedExecutionsPerDeployment},
+		m_debug(_debug),
+		m_observer(std::move(_observer))
 	{}
 
 	NameDispenser m_dispenser;
 	OptimiserStepContext m_context;
 	Debug m_debug;
+	StepObserver m_observer;
 };
 
 }
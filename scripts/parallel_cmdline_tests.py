@@ -0,0 +1,582 @@
+#!/usr/bin/env python3
+
+"""
+Runs the command line tests of test/cmdlineTests.sh in parallel.
+
+Every test case is run by its own worker in a separate temporary directory and the time
+spent on each case is collected. The checks are the same as in test/cmdlineTests.sh,
+including the compilation of test/compilationTests and of the documentation examples,
+the AST import test, the solfuzzer runs and the gas profiler check. In addition, external
+projects can be compiled from local checkouts (e.g. mirrors of the repositories used by
+test/externalTests), using the native compiler instead of solc-js and truffle.
+
+test/cmdlineTests.sh stays the script run by the CI. Expectations are not updated
+interactively; use test/cmdlineTests.sh for that.
+"""
+
+from argparse import ArgumentParser
+from concurrent.futures import ThreadPoolExecutor, as_completed
+import difflib
+import glob
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+REPO_ROOT = os.path.dirname(os.path.dirname(os.path.realpath(__file__)))
+
+SGR_ERROR = "\033[1;31m"
+SGR_OK = "\033[1;32m"
+SGR_CLEAR = "\033[0m"
+
+FULL_ARGS = [
+    "--optimize", "--ignore-missing", "--combined-json",
+    "abi,asm,ast,bin,bin-runtime,compact-format,devdoc,hashes,interface,metadata,opcodes,srcmap,srcmap-runtime,userdoc"
+]
+
+# Optimizer settings used for external projects, corresponding to OPTIMIZER_LEVEL=1 in test/externalTests.
+EXTERNAL_OPTIMIZER_SETTINGS = [
+    ("unoptimized", []),
+    ("optimized", ["--optimize", "--no-optimize-yul"]),
+    ("yul-optimized", ["--optimize"]),
+]
+
+IGNORED_COMPILER_OUTPUT = re.compile(
+    r"Warning: This is a pre-release compiler version|Warning: Experimental features are turned on|"
+    r"pragma experimental ABIEncoderV2|^ +--> |^ +\||^[0-9]+ +\|"
+)
+
+
+class TestFailure(Exception):
+    pass
+
+
+class TestCase:
+    """A named check that is run in its own temporary directory."""
+
+    def __init__(self, group, name, function):
+        self.group = group
+        self.name = name
+        self.function = function
+        self.duration = 0.0
+        self.error = None
+
+    def run(self, solc):
+        workdir = tempfile.mkdtemp(prefix="solc-cmdline-")
+        start = time.monotonic()
+        try:
+            self.function(solc, workdir)
+        except TestFailure as failure:
+            self.error = str(failure)
+        except (OSError, subprocess.SubprocessError) as exception:
+            self.error = "Exception while running the test: {}".format(exception)
+        finally:
+            self.duration = time.monotonic() - start
+            shutil.rmtree(workdir, ignore_errors=True)
+        return self
+
+
+def read_file(path, default=""):
+    try:
+        with open(path, encoding="utf8") as f:
+            return f.read()
+    except FileNotFoundError:
+        return default
+
+
+def strip_trailing_newlines(text):
+    # Command substitution in the shell script removes all trailing newlines.
+    return text.rstrip("\n")
+
+
+def run_solc(solc, args, cwd, stdin=None):
+    result = subprocess.run(
+        [solc] + args,
+        cwd=cwd,
+        input=stdin,
+        stdout=subprocess.PIPE,
+        stderr=subprocess.PIPE,
+        check=False
+    )
+    return result.returncode, result.stdout.decode("utf8", "replace"), result.stderr.decode("utf8", "replace")
+
+
+def normalize_standard_json(stdout):
+    """Applies the same filters as test_solc_behaviour in test/cmdlineTests.sh."""
+    stdout = re.sub(r'{[^{]*Warning: This is a pre-release compiler version[^}]*},?', "", stdout)
+    stdout = re.sub(r' Consider adding \\"pragma solidity \^[0-9.]*;\\"', "", stdout)
+    stdout = re.sub(r'"errors":\[\],?', "", stdout)
+    stdout = re.sub(r'"object":"[a-f0-9]+"', '"object":"bytecode removed"', stdout)
+    stdout = re.sub(r'"opcodes":"[^"]+"', '"opcodes":"opcodes removed"', stdout)
+    stdout = re.sub(r'"sourceMap":"[0-9:;-]+"', '"sourceMap":"sourceMap removed"', stdout)
+    return stdout.replace("\\n", "\n")
+
+
+def normalize_output(stdout, stderr):
+    stdout = re.sub(r"^([ ]*auxdata: )0x[0-9a-f]*$", r"\1AUXDATA REMOVED", stdout, flags=re.MULTILINE)
+    stdout = re.sub(
+        r"^(   [a-zA-Z]+:\s+)[0-9]+ allocations, [0-9]+ bytes allocated, [0-9]+ bytes peak$",
+        r"\1N allocations, N bytes allocated, N bytes peak",
+        stdout,
+        flags=re.MULTILINE
+    )
+    stderr = re.sub(
+        r"^Warning: This is a pre-release compiler version, please do not use it in production.\n?",
+        "",
+        stderr,
+        flags=re.MULTILINE
+    )
+    stderr = re.sub(r' Consider adding "pragma .*$', "", stderr, flags=re.MULTILINE)
+    if stderr.startswith("\n"):
+        stderr = stderr[1:]
+    return stdout, stderr
+
+
+def normalize_exceptions(stderr):
+    stderr = re.sub(r"^(Exception while assembling:).*$", r"\1", stderr, flags=re.MULTILINE)
+    return re.sub(r"^(Dynamic exception type:).*$", r"\1", stderr, flags=re.MULTILINE)
+
+
+def isolate_tests(workdir, directory, *args):
+    """Extracts the sources in the given directory of the repository into workdir."""
+    subprocess.run(
+        [os.path.join(REPO_ROOT, "scripts", "isolate_tests.py"), os.path.join(REPO_ROOT, directory)] + list(args),
+        cwd=workdir,
+        stdout=subprocess.DEVNULL,
+        check=True
+    )
+
+
+def compare(description, expected, actual):
+    expected = strip_trailing_newlines(expected)
+    actual = strip_trailing_newlines(actual)
+    if expected != actual:
+        diff = difflib.unified_diff(
+            expected.splitlines(),
+            actual.splitlines(),
+            "expected", "obtained", lineterm=""
+        )
+        raise TestFailure("Incorrect output on {}:\n{}".format(description, "\n".join(diff)))
+
+
+def check_solc_behaviour(solc, workdir, args, stdin, expected_stdout, expected_exit_code, expected_stderr):
+    exit_code, stdout, stderr = run_solc(solc, args, workdir, stdin)
+    if "--standard-json" in args:
+        stdout = normalize_standard_json(stdout)
+    else:
+        stdout, stderr = normalize_output(stdout, stderr)
+    stderr = normalize_exceptions(stderr)
+
+    if exit_code != expected_exit_code:
+        raise TestFailure("Incorrect exit code. Expected {} but got {}.\n{}".format(expected_exit_code, exit_code, stderr))
+    compare("stdout", expected_stdout, stdout)
+    compare("stderr", expected_stderr, stderr)
+
+
+def cmdline_test(test_dir):
+    """Creates the check for a directory in test/cmdlineTests."""
+    def run(solc, workdir):
+        # The tests refer to their input files relative to test/cmdlineTests.
+        shutil.copytree(test_dir, os.path.join(workdir, os.path.basename(test_dir)))
+        name = os.path.basename(test_dir) + "/"
+        extra_args = read_file(os.path.join(test_dir, "args")).split()
+        if os.path.exists(os.path.join(test_dir, "input.json")):
+            args = ["--standard-json"] + extra_args
+            stdin = read_file(os.path.join(test_dir, "input.json")).encode("utf8")
+            expected_stdout = read_file(os.path.join(test_dir, "output.json"))
+        else:
+            args = [name + "input.sol"] + extra_args
+            stdin = b""
+            expected_stdout = read_file(os.path.join(test_dir, "output"))
+        expected_exit_code = int(read_file(os.path.join(test_dir, "exit"), "0").strip() or "0")
+        expected_stderr = read_file(os.path.join(test_dir, "err"))
+        check_solc_behaviour(solc, workdir, args, stdin, expected_stdout, expected_exit_code, expected_stderr)
+    return run
+
+
+def compile_full(solc, cwd, files, expect_failure=False, expect_output=False, allow_output=False):
+    """
+    Equivalent of compileFull in scripts/common_cmdline.sh. The flags correspond to its
+    options -e (expect_failure), -w (expect_output) and -o (allow_output).
+    """
+    exit_code, _, stderr = run_solc(solc, FULL_ARGS + files, cwd)
+    errors = "\n".join(line for line in stderr.splitlines() if not IGNORED_COMPILER_OUTPUT.search(line))
+    if expect_failure:
+        expect_output = True
+    if (
+        exit_code != (1 if expect_failure else 0) or
+        (not expect_output and not allow_output and errors) or
+        (expect_output and not expect_failure and not allow_output and not errors)
+    ):
+        raise TestFailure(
+            "Unexpected compilation result:\n"
+            "Expected failure: {} - Expected warning / error output: {}\n"
+            "Was failure: {}\n{}".format(expect_failure, expect_output, exit_code, errors)
+        )
+
+
+def compilation_test(test_dir):
+    """Creates the check for a directory in test/compilationTests."""
+    def run(solc, workdir):
+        # Like the shell, pass patterns without matches literally. They are reported as
+        # missing files, which counts as the expected output.
+        files = []
+        for pattern in ["*.sol", "*/*.sol"]:
+            matches = sorted(os.path.relpath(path, test_dir) for path in glob.glob(os.path.join(test_dir, pattern)))
+            files += matches or [pattern]
+        compile_full(solc, test_dir, files, expect_output=True)
+    return run
+
+
+def docs_example_test(path):
+    """Creates the check for a code example extracted from the documentation."""
+    def run(solc, workdir):
+        source = read_file(path)
+        # We expect errors if explicitly stated, or if imports are used (in the style guide).
+        compile_full(
+            solc,
+            workdir,
+            [path],
+            expect_failure=re.search(r'This will not compile|import "', source) is not None,
+            expect_output="This will report a warning" in source,
+            allow_output="This may report a warning" in source
+        )
+    return run
+
+
+def docs_example_tests(scratch_dir):
+    """Extracts the code examples from the documentation into scratch_dir."""
+    isolate_tests(scratch_dir, "docs", "docs")
+    tests = []
+    for name in sorted(os.listdir(scratch_dir)):
+        # The contributors guide uses syntax tests, but we cannot really handle them here.
+        if name.endswith(".sol") and not re.search(r"DeclarationError:|// ----", read_file(os.path.join(scratch_dir, name))):
+            tests.append(TestCase("docs", name, docs_example_test(os.path.join(scratch_dir, name))))
+    return tests
+
+
+def misc_tests(solfuzzer, gasprofiler):
+    """The checks of test/cmdlineTests.sh that are not based on test directories."""
+    def bug_list(solc, workdir):
+        result = subprocess.run(
+            [os.path.join(REPO_ROOT, "scripts", "update_bugs_by_version.py")],
+            stdout=subprocess.PIPE,
+            stderr=subprocess.STDOUT,
+            check=False
+        )
+        if result.returncode != 0:
+            raise TestFailure("The bug list is not up to date:\n" + result.stdout.decode("utf8", "replace"))
+
+    def unknown_option(solc, workdir):
+        exit_code, _, stderr = run_solc(solc, ["--allow=test"], workdir)
+        if exit_code == 0 or stderr.strip() != "unrecognised option '--allow=test'":
+            raise TestFailure("Incorrect response to unknown options: " + stderr)
+
+    def file_not_found(solc, workdir):
+        check_solc_behaviour(solc, workdir, ["file_not_found.sol"], b"", "", 1, '"file_not_found.sol" is not found.')
+
+    def not_a_file(solc, workdir):
+        check_solc_behaviour(solc, workdir, ["."], b"", "", 1, '"." is not a valid file.')
+
+    def empty_remappings(solc, workdir):
+        # Any existing file can be used, since the remapping is rejected first.
+        script = os.path.join(REPO_ROOT, "test", "cmdlineTests.sh")
+        for remapping in ["=/some/remapping/target", "ctx:=/some/remapping/target"]:
+            check_solc_behaviour(solc, workdir, [script, remapping], b"", "", 1, 'Invalid remapping: "{}".'.format(remapping))
+
+    def library_checksum(solc, workdir):
+        if run_solc(solc, ["-", "--link", "--libraries", "a:0x90f20564390eAe531E810af625A22f51385Cd222"], workdir, b"\n")[0] != 0:
+            raise TestFailure("Linking with a valid checksum failed.")
+        if run_solc(solc, ["-", "--link", "--libraries", "a:0x80f20564390eAe531E810af625A22f51385Cd222"], workdir, b"\n")[0] == 0:
+            raise TestFailure("Linking with an invalid checksum succeeded.")
+
+    def long_library_name(solc, workdir):
+        library = "a" + "v" + "e" * 400 + "rylonglibraryname:0x90f20564390eAe531E810af625A22f51385Cd222"
+        if run_solc(solc, ["-", "--link", "--libraries", library], workdir, b"\n")[0] != 0:
+            raise TestFailure("Linking with a long library name failed.")
+
+    def linking(solc, workdir):
+        with open(os.path.join(workdir, "x.sol"), "w") as f:
+            f.write("library L { function f() public pure {} } contract C { function f() public pure { L.f(); } }\n")
+        if run_solc(solc, ["--bin", "-o", ".", "x.sol"], workdir)[0] != 0:
+            raise TestFailure("Compilation failed.")
+        binary = read_file(os.path.join(workdir, "C.bin"))
+        if "//" not in binary or "__" not in binary:
+            raise TestFailure("Placeholder or explanation missing in C.bin.")
+        if re.search("[/_]", read_file(os.path.join(workdir, "L.bin"))):
+            raise TestFailure("Unexpected placeholder in L.bin.")
+        run_solc(solc, ["--link", "--libraries", "x.sol:L:0x90f20564390eAe531E810af625A22f51385Cd222", "C.bin"], workdir)
+        if re.search("[/_]", read_file(os.path.join(workdir, "C.bin"))):
+            raise TestFailure("Placeholder left in C.bin after linking.")
+
+    def overwriting(solc, workdir):
+        args = ["-", "--bin", "-o", os.path.join(workdir, "out")]
+        source = b"contract C {}\n"
+        if run_solc(solc, args, workdir, source)[0] != 0:
+            raise TestFailure("First compilation failed.")
+        if run_solc(solc, args, workdir, source)[0] == 0:
+            raise TestFailure("Overwriting files succeeded without --overwrite.")
+        if run_solc(solc, args + ["--overwrite"], workdir, source)[0] != 0:
+            raise TestFailure("Overwriting files failed with --overwrite.")
+
+    def assembly(solc, workdir):
+        for mode in ["--assemble", "--yul", "--strict-assembly"]:
+            if run_solc(solc, ["-", mode], workdir, b"{}\n")[0] != 0:
+                raise TestFailure("Assembling with {} failed.".format(mode))
+        # Using --assemble or --yul together with --optimize should fail.
+        for mode in ["--assemble", "--yul"]:
+            if run_solc(solc, ["-", mode, "--optimize"], workdir, b"{}\n")[0] == 0:
+                raise TestFailure("Assembling with {} and --optimize succeeded.".format(mode))
+        # Non-empty code results in non-empty binary representation with optimizations turned off,
+        # while it results in empty binary representation with optimizations turned on.
+        for source, expected, args in [
+            ("{ let x:u256 := 0:u256 }", "{ let x := 0 }", ["--yul"]),
+            ("{ let x:u256 := bitnot(7:u256) }", "{ let x := bitnot(7) }", ["--yul"]),
+            ("{ let t:bool := not(true) }", "{ let t:bool := not(true) }", ["--yul"]),
+            ("{ let x := 0 }", "{ let x := 0 }", ["--strict-assembly"]),
+            ("{ let x := 0 }", "{ { } }", ["--strict-assembly", "--optimize"]),
+        ]:
+            _, stdout, _ = run_solc(solc, ["-"] + args, workdir, (source + "\n").encode("utf8"))
+            expected_object = 'object "object" { code ' + expected + ' }'
+            if expected_object not in " ".join(stdout.split()):
+                raise TestFailure("Incorrect assembly output. Expected:\n{}\nwith arguments {}, but got:\n{}".format(
+                    expected, " ".join(args), stdout
+                ))
+
+    def standard_input(solc, workdir):
+        exit_code, _, stderr = run_solc(solc, ["--bin"], workdir, b"")
+        if exit_code == 0 or "No input files given" not in stderr:
+            raise TestFailure("Incorrect response to empty input arg list: " + stderr)
+        exit_code, stdout, _ = run_solc(solc, ["-", "--bin"], workdir, b"contract C {}\n")
+        if exit_code != 0 or "<stdin>:C" not in stdout:
+            raise TestFailure("Contract from standard input was not compiled.")
+        # test/cmdlineTests.sh uses --ast, which no longer exists, and ignores the result.
+        if run_solc(solc, ["--ast-json", "-"], workdir, b"\n")[0] != 0:
+            raise TestFailure("Empty standard input was not accepted.")
+
+    def ast_import(solc, workdir):
+        # The script finds solc through SOLIDITY_BUILD_DIR, relative to the repository root.
+        build_dir = os.path.relpath(os.path.dirname(os.path.dirname(solc)), REPO_ROOT)
+        result = subprocess.run(
+            [os.path.join(REPO_ROOT, "scripts", "ASTImportTest.sh")],
+            cwd=workdir,
+            env=dict(os.environ, SOLIDITY_BUILD_DIR=build_dir),
+            stdout=subprocess.PIPE,
+            stderr=subprocess.STDOUT,
+            check=False
+        )
+        if result.returncode != 0:
+            raise TestFailure("AST import test failed:\n" + result.stdout.decode("utf8", "replace"))
+
+    def fuzzer(extra_args):
+        def run(solc, workdir):
+            if not os.path.isfile(solfuzzer):
+                raise TestFailure("solfuzzer not found at " + solfuzzer)
+            isolate_tests(workdir, "test")
+            isolate_tests(workdir, "docs", "docs")
+            files = sorted(f for f in os.listdir(workdir) if f.endswith(".sol"))
+            for i in range(0, len(files), 50):
+                result = subprocess.run(
+                    [solfuzzer] + extra_args + ["--quiet", "--input-files"] + files[i:i + 50],
+                    cwd=workdir,
+                    stdout=subprocess.PIPE,
+                    stderr=subprocess.STDOUT,
+                    check=False
+                )
+                if result.returncode != 0:
+                    raise TestFailure("solfuzzer failed:\n" + result.stdout.decode("utf8", "replace"))
+        return run
+
+    def gas_profiler(solc, workdir):
+        if not os.path.isfile(gasprofiler):
+            raise TestFailure("gasprofiler not found at " + gasprofiler)
+        # The value of the immutable is only inserted into the code at deployment.
+        with open(os.path.join(workdir, "c.sol"), "w", encoding="utf8") as f:
+            f.write("pragma solidity >=0.0; contract C { uint immutable x; uint y; constructor() public { x = 7; } function f() public { y = x; } }\n")
+        result = subprocess.run(
+            [gasprofiler, "c.sol", "--calldata", "26121ff0"],
+            cwd=workdir,
+            stdout=subprocess.PIPE,
+            stderr=subprocess.STDOUT,
+            check=False
+        )
+        output = result.stdout.decode("utf8", "replace")
+        if result.returncode != 0 or not re.search(r"  C\.f$", output, re.MULTILINE) or "<unknown code>" in output:
+            raise TestFailure("Incorrect gas profile:\n" + output)
+        for args in [["--value", "abc"], ["--constructor-args", "zz"], ["--calldata", "zz"]]:
+            result = subprocess.run([gasprofiler, "c.sol"] + args, cwd=workdir, stdout=subprocess.PIPE, stderr=subprocess.PIPE, check=False)
+            if result.returncode != 1:
+                raise TestFailure("Incorrect exit code for {}. Expected 1 but got {}.".format(" ".join(args), result.returncode))
+
+    return [
+        ("bug list", bug_list),
+        ("unknown option", unknown_option),
+        ("file not found", file_not_found),
+        ("not a file", not_a_file),
+        ("empty remappings", empty_remappings),
+        ("library checksum", library_checksum),
+        ("long library name", long_library_name),
+        ("linking", linking),
+        ("overwriting files", overwriting),
+        ("assembly", assembly),
+        ("standard input", standard_input),
+        ("AST import", ast_import),
+        ("solfuzzer", fuzzer([])),
+        ("solfuzzer without optimizer", fuzzer(["--without-optimizer"])),
+        ("gas profiler", gas_profiler),
+    ]
+
+
+def remappings_for(project_dir):
+    """Remappings for all packages in node_modules, as resolved by truffle."""
+    modules = os.path.join(project_dir, "node_modules")
+    if not os.path.isdir(modules):
+        return []
+    remappings = []
+    for package in sorted(os.listdir(modules)):
+        if package.startswith("@"):
+            packages = [package + "/" + scoped for scoped in sorted(os.listdir(os.path.join(modules, package)))]
+        else:
+            packages = [package]
+        remappings += ["{0}/=node_modules/{0}/".format(p) for p in packages]
+    return remappings
+
+
+def external_test(mirror, optimizer_args):
+    """Creates the check compiling the contracts of a local checkout of an external project."""
+    def run(solc, workdir):
+        project_dir = os.path.join(workdir, "ext")
+        shutil.copytree(mirror, project_dir, symlinks=True, ignore=shutil.ignore_patterns(".git", "build"))
+        contracts_dir = os.path.join(project_dir, "contracts")
+        if not os.path.isdir(contracts_dir):
+            contracts_dir = project_dir
+        files = []
+        for root, dirs, filenames in os.walk(project_dir):
+            in_contracts = os.path.commonpath([root, contracts_dir]) == contracts_dir
+            for f in filenames:
+                if not f.endswith(".sol"):
+                    continue
+                # Equivalent of replace_version_pragmas in test/externalTests/common.sh,
+                # which includes all directories to also cover node dependencies.
+                path = os.path.join(root, f)
+                source = re.sub(r"pragma solidity [\^0-9.]*", "pragma solidity >=0.0", read_file(path))
+                with open(path, "w", encoding="utf8") as out:
+                    out.write(source)
+                if in_contracts and "node_modules" not in os.path.relpath(root, project_dir).split(os.sep):
+                    files.append(os.path.relpath(path, project_dir))
+        if not files:
+            raise TestFailure("No Solidity files found in " + mirror)
+        args = optimizer_args + ["--allow-paths", project_dir, "--bin", "-o", os.path.join(workdir, "build")]
+        exit_code, _, stderr = run_solc(solc, remappings_for(project_dir) + args + sorted(files), project_dir)
+        if exit_code != 0:
+            raise TestFailure("Compilation failed:\n" + stderr)
+    return run
+
+
+def collect_tests(options, scratch_dir):
+    tests = []
+    if not options.skip_cmdline:
+        tools_dir = os.path.join(os.path.dirname(os.path.dirname(os.path.abspath(options.solc))), "test", "tools")
+        solfuzzer = options.solfuzzer or os.path.join(tools_dir, "solfuzzer")
+        gasprofiler = options.gasprofiler or os.path.join(tools_dir, "gasprofiler")
+        tests += [TestCase("misc", name, function) for name, function in misc_tests(solfuzzer, gasprofiler)]
+        cmdline_dir = os.path.join(REPO_ROOT, "test", "cmdlineTests")
+        for name in sorted(os.listdir(cmdline_dir)):
+            if os.path.isdir(os.path.join(cmdline_dir, name)):
+                tests.append(TestCase("cmdline", name, cmdline_test(os.path.join(cmdline_dir, name))))
+        compilation_dir = os.path.join(REPO_ROOT, "test", "compilationTests")
+        for name in sorted(os.listdir(compilation_dir)):
+            if os.path.isdir(os.path.join(compilation_dir, name)):
+                tests.append(TestCase("compilation", name, compilation_test(os.path.join(compilation_dir, name))))
+        tests += docs_example_tests(scratch_dir)
+    for mirror in options.external:
+        mirror = os.path.abspath(mirror)
+        for setting, args in EXTERNAL_OPTIMIZER_SETTINGS:
+            name = "{} ({})".format(os.path.basename(mirror.rstrip(os.sep)), setting)
+            tests.append(TestCase("external", name, external_test(mirror, args)))
+    if options.filter:
+        pattern = re.compile(options.filter)
+        tests = [t for t in tests if pattern.search("{}/{}".format(t.group, t.name))]
+    return tests
+
+
+def parse_arguments():
+    parser = ArgumentParser(description=__doc__)
+    parser.add_argument(
+        "--solc",
+        default=os.path.join(REPO_ROOT, os.environ.get("SOLIDITY_BUILD_DIR", "build"), "solc", "solc"),
+        help="Path to the solc executable."
+    )
+    parser.add_argument(
+        "--solfuzzer",
+        help="Path to the solfuzzer executable. Defaults to test/tools/solfuzzer in the build directory of solc."
+    )
+    parser.add_argument(
+        "--gasprofiler",
+        help="Path to the gasprofiler executable. Defaults to test/tools/gasprofiler in the build directory of solc."
+    )
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count() or 1, help="Number of tests run at the same time.")
+    parser.add_argument("--filter", help="Only run tests whose \"group/name\" matches this regular expression.")
+    parser.add_argument(
+        "--external",
+        action="append",
+        default=[],
+        metavar="DIR",
+        help="Compile the external project checked out in DIR (can be given multiple times)."
+    )
+    parser.add_argument("--skip-cmdline", action="store_true", help="Only run the external projects.")
+    parser.add_argument("--timings", metavar="FILE", help="Write the duration of each test as JSON to FILE.")
+    parser.add_argument("--slowest", type=int, default=10, help="Number of slowest tests to list.")
+    return parser.parse_args()
+
+
+def main():
+    options = parse_arguments()
+    if not os.path.isfile(options.solc):
+        sys.exit("solc not found at {}".format(options.solc))
+    solc = os.path.abspath(options.solc)
+
+    start = time.monotonic()
+    failures = []
+    # Holds the documentation examples, which are extracted once for all tests.
+    with tempfile.TemporaryDirectory(prefix="solc-cmdline-docs-") as scratch_dir:
+        tests = collect_tests(options, scratch_dir)
+        with ThreadPoolExecutor(max_workers=max(options.jobs, 1)) as executor:
+            futures = [executor.submit(test.run, solc) for test in tests]
+            for future in as_completed(futures):
+                test = future.result()
+                if test.error is None:
+                    print("{}PASS{} {}/{} ({:.2f}s)".format(SGR_OK, SGR_CLEAR, test.group, test.name, test.duration))
+                else:
+                    failures.append(test)
+                    print("{}FAIL{} {}/{} ({:.2f}s)\n{}".format(SGR_ERROR, SGR_CLEAR, test.group, test.name, test.duration, test.error))
+    elapsed = time.monotonic() - start
+
+    print("\nSlowest tests:")
+    for test in sorted(tests, key=lambda t: t.duration, reverse=True)[:options.slowest]:
+        print("  {:8.2f}s {}/{}".format(test.duration, test.group, test.name))
+    print("\n{} tests, {} failed, {:.2f}s elapsed, {:.2f}s total test time.".format(
+        len(tests), len(failures), elapsed, sum(t.duration for t in tests)
+    ))
+
+    if options.timings:
+        with open(options.timings, "w", encoding="utf8") as f:
+            json.dump(
+                [
+                    {"group": t.group, "name": t.name, "seconds": round(t.duration, 3), "passed": t.error is None}
+                    for t in tests
+                ],
+                f,
+                indent=2
+            )
+
+    if failures:
+        sys.exit("Failed tests: " + ", ".join("{}/{}".format(t.group, t.name) for t in failures))
+
+
+if __name__ == "__main__":
+    main()
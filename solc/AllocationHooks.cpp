@@ -0,0 +1,121 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Replacement of the global allocation functions that reports all allocations
+ * to AllocationStatistics.
+ */
+
+#include <libsolutil/AllocationStatistics.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+using namespace solidity::util;
+
+namespace
+{
+
+/// The size of each block is stored in front of it. The header keeps the alignment
+/// guarantee of operator new.
+constexpr size_t c_headerSize = alignof(std::max_align_t);
+
+void* allocate(size_t _size) noexcept
+{
+	void* block = std::malloc(_size + c_headerSize);
+	if (!block)
+		return nullptr;
+	*static_cast<size_t*>(block) = _size;
+	AllocationStatistics::recordAllocation(_size);
+	return static_cast<char*>(block) + c_headerSize;
+}
+
+void deallocate(void* _pointer) noexcept
+{
+	if (!_pointer)
+		return;
+	void* block = static_cast<char*>(_pointer) - c_headerSize;
+	AllocationStatistics::recordDeallocation(*static_cast<size_t*>(block));
+	std::free(block);
+}
+
+}
+
+void* operator new(size_t _size)
+{
+	while (true)
+	{
+		if (void* pointer = allocate(_size))
+			return pointer;
+		if (std::new_handler handler = std::get_new_handler())
+			handler();
+		else
+			throw std::bad_alloc();
+	}
+}
+
+void* operator new[](size_t _size)
+{
+	return operator new(_size);
+}
+
+void* operator new(size_t _size, std::nothrow_t const&) noexcept
+{
+	try
+	{
+		return operator new(_size);
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+void* operator new[](size_t _size, std::nothrow_t const&) noexcept
+{
+	return operator new(_size, std::nothrow);
+}
+
+void operator delete(void* _pointer) noexcept
+{
+	deallocate(_pointer);
+}
+
+void operator delete[](void* _pointer) noexcept
+{
+	deallocate(_pointer);
+}
+
+void operator delete(void* _pointer, size_t) noexcept
+{
+	deallocate(_pointer);
+}
+
+void operator delete[](void* _pointer, size_t) noexcept
+{
+	deallocate(_pointer);
+}
+
+void operator delete(void* _pointer, std::nothrow_t const&) noexcept
+{
+	deallocate(_pointer);
+}
+
+void operator delete[](void* _pointer, std::nothrow_t const&) noexcept
+{
+	deallocate(_pointer);
+}
@@ -46,10 +46,12 @@
 #include <liblangutil/SourceReferenceFormatter.h>
 #include <liblangutil/SourceReferenceFormatterHuman.h>
 
+#include <libsolutil/AllocationStatistics.h>
 #include <libsolutil/Common.h>
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/MappedFile.h>
 
 #include <memory>
 
@@ -103,6 +105,7 @@ std::ostream& serr(bool _used = true)
 
 static string const g_stdinFileNameStr = "<stdin>";
 static string const g_strAbi = "abi";
+static string const g_strAllocationStatistics = "allocation-statistics";
 static string const g_strAllowPaths = "allow-paths";
 static string const g_strAsm = "asm";
 static string const g_strAsmJson = "asm-json";
@@ -173,8 +176,10 @@ static string const g_strIgnoreMissingFiles = "ignore-missing";
 static string const g_strColor = "color";
 static string const g_strNoColor = "no-color";
 static string const g_strOldReporter = "old-reporter";
+static string const g_strMaxRepeatedWarnings = "max-repeated-warnings";
 
 static string const g_argAbi = g_strAbi;
+static string const g_argAllocationStatistics = g_strAllocationStatistics;
 static string const g_argPrettyJson = g_strPrettyJson;
 static string const g_argAllowPaths = g_strAllowPaths;
 static string const g_argAsm = g_strAsm;
@@ -217,6 +222,7 @@ static string const g_argIgnoreMissingFiles = g_strIgnoreMissingFiles;
 static string const g_argColor = g_strColor;
 static string const g_argNoColor = g_strNoColor;
 static string const g_argOldReporter = g_strOldReporter;
+static string const g_argMaxRepeatedWarnings = g_strMaxRepeatedWarnings;
 
 /// Possible arguments to for --combined-json
 static set<string> const g_combinedJsonArgs
@@ -528,10 +534,46 @@ void CommandLineInterface::handleGasEstimation(string const& _contract)
 	}
 }
 
+void CommandLineInterface::handleAllocationStatistics()
+{
+	if (!AllocationStatistics::available())
+	{
+		serr() << "Allocation statistics are not available in this build of the compiler." << endl;
+		return;
+	}
+
+	auto printCounters = [&](string const& _name, AllocationCounters const& _counters)
+	{
+		sout() << "   " << _name << ":\t";
+		sout() << _counters.allocations << " allocations, ";
+		sout() << _counters.allocatedBytes << " bytes allocated, ";
+		sout() << _counters.peakBytes << " bytes peak" << endl;
+	};
+
+	sout() << endl << "Allocation statistics:" << endl;
+	printCounters("total", AllocationStatistics::total());
+	for (auto const& [phase, counters]: AllocationStatistics::phases())
+		printCounters(phase, counters);
+	for (auto const& [contract, phases]: AllocationStatistics::contracts())
+	{
+		sout() << contract << ":" << endl;
+		for (auto const& [phase, counters]: phases)
+			printCounters(phase, counters);
+	}
+}
+
 bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 {
 	bool ignoreMissing = m_args.count(g_argIgnoreMissingFiles);
 	bool addStdin = false;
+	// The compiler references the mapped input files. Only linking, assembling and
+	// importing ASTs need the inputs as strings.
+	bool const readAsString =
+		m_args.count(g_argLink) ||
+		m_args.count(g_argAssemble) ||
+		m_args.count(g_argStrictAssembly) ||
+		m_args.count(g_argYul) ||
+		m_args.count(g_argImportAst);
 	if (m_args.count(g_argInputFile))
 		for (string path: m_args[g_argInputFile].as<vector<string>>())
 		{
@@ -580,14 +622,27 @@ bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 					continue;
 				}
 
-				m_sourceCodes[infile.generic_string()] = readFileAsString(infile.string());
+				if (readAsString)
+					m_sourceCodes[infile.generic_string()] = readFileAsString(infile.string());
+				else if (auto file = MappedFile::open(infile.string()))
+					m_sourceFiles[infile.generic_string()] = std::move(file);
+				else
+				{
+					serr() << infile << " could not be read." << endl;
+					return false;
+				}
 				path = boost::filesystem::canonical(infile).string();
 			}
 			m_allowedDirectories.push_back(boost::filesystem::path(path).remove_filename());
 		}
 	if (addStdin)
-		m_sourceCodes[g_stdinFileName] = readStandardInput();
-	if (m_sourceCodes.size() == 0)
+	{
+		if (readAsString)
+			m_sourceCodes[g_stdinFileName] = readStandardInput();
+		else
+			m_sourceFiles[g_stdinFileName] = MappedFile::fromContents(readStandardInput());
+	}
+	if (m_sourceCodes.empty() && m_sourceFiles.empty())
 	{
 		serr() << "No input files given. If you wish to use the standard input please specify \"-\" explicitly." << endl;
 		return false;
@@ -780,6 +835,11 @@ Allowed options)",
 			"Output a single json document containing the specified information."
 		)
 		(g_argGas.c_str(), "Print an estimate of the maximal gas usage for each function.")
+		(
+			g_argAllocationStatistics.c_str(),
+			"Print the number and size of heap allocations and the peak heap usage "
+			"for each compiler phase and each contract."
+		)
 		(
 			g_argStandardJSON.c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
@@ -832,6 +892,11 @@ Allowed options)",
 		(g_argColor.c_str(), "Force colored output.")
 		(g_argNoColor.c_str(), "Explicitly disable colored output, disabling terminal auto-detection.")
 		(g_argOldReporter.c_str(), "Enables old diagnostics reporter.")
+		(
+			g_argMaxRepeatedWarnings.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Print at most n warnings with the same message and skip diagnostics that are identical to one printed before."
+		)
 		(g_argErrorRecovery.c_str(), "Enables additional parser error recovery.")
 		(g_argIgnoreMissingFiles.c_str(), "Ignore missing files.");
 	po::options_description outputComponents("Output Components");
@@ -933,6 +998,14 @@ Allowed options)",
 	return true;
 }
 
+void CommandLineInterface::printErrors(SourceReferenceFormatter& _formatter, ErrorList const& _errors)
+{
+	if (m_args.count(g_argMaxRepeatedWarnings))
+		_formatter.printErrorInformation(_errors, true, m_args[g_argMaxRepeatedWarnings].as<unsigned>());
+	else
+		_formatter.printErrorInformation(_errors);
+}
+
 bool CommandLineInterface::processInput()
 {
 	ReadCallback::Callback fileReader = [this](string const& _kind, string const& _path)
@@ -968,9 +1041,12 @@ bool CommandLineInterface::processInput()
 			if (!boost::filesystem::is_regular_file(canonicalPath))
 				return ReadCallback::Result{false, "Not a valid file."};
 
-			auto contents = readFileAsString(canonicalPath.string());
-			m_sourceCodes[path.generic_string()] = contents;
-			return ReadCallback::Result{true, contents};
+			// The contents are only referenced by the compiler, which keeps the file mapped
+			// as long as it needs it.
+			auto file = MappedFile::open(canonicalPath.string());
+			if (!file)
+				return ReadCallback::Result{false, "Could not read file."};
+			return ReadCallback::Result{true, string(), std::move(file)};
 		}
 		catch (Exception const& _exception)
 		{
@@ -1017,7 +1093,8 @@ bool CommandLineInterface::processInput()
 		else
 			input = readFileAsString(jsonFile);
 		StandardCompiler compiler(fileReader);
-		sout() << compiler.compile(std::move(input)) << endl;
+		compiler.compile(input, sout());
+		sout() << endl;
 		return true;
 	}
 
@@ -1176,8 +1253,7 @@ bool CommandLineInterface::processInput()
 
 				if (!m_compiler->analyze())
 				{
-					for (auto const& error: m_compiler->errors())
-						formatter->printErrorInformation(*error);
+					printErrors(*formatter, m_compiler->errors());
 					astAssert(false, "Analysis of the AST failed");
 				}
 			}
@@ -1189,17 +1265,20 @@ bool CommandLineInterface::processInput()
 		}
 		else
 		{
-			m_compiler->setSources(m_sourceCodes);
+			m_compiler->setSourceFiles(std::move(m_sourceFiles));
 			if (m_args.count(g_argErrorRecovery))
 				m_compiler->setParserErrorRecovery(true);
 		}
 
+		if (m_args.count(g_argAllocationStatistics))
+			AllocationStatistics::enable();
 		bool successful = m_compiler->compile();
+		AllocationStatistics::disable();
 
-		for (auto const& error: m_compiler->errors())
+		if (!m_compiler->errors().empty())
 		{
 			g_hasOutput = true;
-			formatter->printErrorInformation(*error);
+			printErrors(*formatter, m_compiler->errors());
 		}
 
 		if (!successful)
@@ -1328,11 +1407,11 @@ void CommandLineInterface::handleCombinedJSON()
 	{
 		bool legacyFormat = !requests.count(g_strCompactJSON);
 		output[g_strSources] = Json::Value(Json::objectValue);
-		for (auto const& sourceCode: m_sourceCodes)
+		for (string const& sourceName: m_compiler->sourceNames())
 		{
 			ASTJsonConverter converter(legacyFormat, m_compiler->sourceIndices());
-			output[g_strSources][sourceCode.first] = Json::Value(Json::objectValue);
-			output[g_strSources][sourceCode.first]["AST"] = converter.toJson(m_compiler->ast(sourceCode.first));
+			output[g_strSources][sourceName] = Json::Value(Json::objectValue);
+			output[g_strSources][sourceName]["AST"] = converter.toJson(m_compiler->ast(sourceName));
 		}
 	}
 
@@ -1359,8 +1438,8 @@ void CommandLineInterface::handleAst(string const& _argStr)
 	if (m_args.count(_argStr))
 	{
 		vector<ASTNode const*> asts;
-		for (auto const& sourceCode: m_sourceCodes)
-			asts.push_back(&m_compiler->ast(sourceCode.first));
+		for (string const& sourceName: m_compiler->sourceNames())
+			asts.push_back(&m_compiler->ast(sourceName));
 		map<ASTNode const*, evmasm::GasMeter::GasConsumption> gasCosts;
 		for (auto const& contract: m_compiler->contractNames())
 			if (m_compiler->compilationSuccessful())
@@ -1377,23 +1456,23 @@ void CommandLineInterface::handleAst(string const& _argStr)
 		bool legacyFormat = !m_args.count(g_argAstCompactJson);
 		if (m_args.count(g_argOutputDir))
 		{
-			for (auto const& sourceCode: m_sourceCodes)
+			for (string const& sourceName: m_compiler->sourceNames())
 			{
 				stringstream data;
 				string postfix = "";
-				ASTJsonConverter(legacyFormat, m_compiler->sourceIndices()).print(data, m_compiler->ast(sourceCode.first));
+				ASTJsonConverter(legacyFormat, m_compiler->sourceIndices()).print(data, m_compiler->ast(sourceName));
 				postfix += "_json";
-				boost::filesystem::path path(sourceCode.first);
+				boost::filesystem::path path(sourceName);
 				createFile(path.filename().string() + postfix + ".ast", data.str());
 			}
 		}
 		else
 		{
 			sout() << title << endl << endl;
-			for (auto const& sourceCode: m_sourceCodes)
+			for (string const& sourceName: m_compiler->sourceNames())
 			{
-				sout() << endl << "======= " << sourceCode.first << " =======" << endl;
-				ASTJsonConverter(legacyFormat, m_compiler->sourceIndices()).print(sout(), m_compiler->ast(sourceCode.first));
+				sout() << endl << "======= " << sourceName << " =======" << endl;
+				ASTJsonConverter(legacyFormat, m_compiler->sourceIndices()).print(sout(), m_compiler->ast(sourceName));
 			}
 		}
 	}
@@ -1550,10 +1629,10 @@ bool CommandLineInterface::assemble(
 		else
 			formatter = make_unique<SourceReferenceFormatterHuman>(serr(false), m_coloredOutput);
 
-		for (auto const& error: stack.errors())
+		if (!stack.errors().empty())
 		{
 			g_hasOutput = true;
-			formatter->printErrorInformation(*error);
+			printErrors(*formatter, stack.errors());
 		}
 		if (!Error::containsOnlyWarnings(stack.errors()))
 			successful = false;
@@ -1638,6 +1717,12 @@ void CommandLineInterface::outputCompilationResults()
 		return;
 	}
 
+	// Imported sources are only kept by the compiler, so collect all sources for the assembly output.
+	StringMap sourceCodes;
+	if (m_args.count(g_argAsm) && !m_args.count(g_argAsmJson))
+		for (string const& sourceName: m_compiler->sourceNames())
+			sourceCodes[sourceName] = string(m_compiler->scanner(sourceName).source());
+
 	vector<string> contracts = m_compiler->contractNames();
 	for (string const& contract: contracts)
 	{
@@ -1651,7 +1736,7 @@ void CommandLineInterface::outputCompilationResults()
 			if (m_args.count(g_argAsmJson))
 				ret = jsonPrettyPrint(m_compiler->assemblyJSON(contract));
 			else
-				ret = m_compiler->assemblyString(contract, m_sourceCodes);
+				ret = m_compiler->assemblyString(contract, sourceCodes);
 
 			if (m_args.count(g_argOutputDir))
 			{
@@ -1678,6 +1763,9 @@ void CommandLineInterface::outputCompilationResults()
 		handleNatspec(false, contract);
 	} // end of contracts iteration
 
+	if (m_args.count(g_argAllocationStatistics))
+		handleAllocationStatistics();
+
 	if (!g_hasOutput)
 	{
 		if (m_args.count(g_argOutputDir))
@@ -31,6 +31,11 @@
 
 #include <memory>
 
+namespace solidity::langutil
+{
+class SourceReferenceFormatter;
+}
+
 namespace solidity::frontend
 {
 
@@ -73,10 +78,14 @@ private:
 	void handleABI(std::string const& _contract);
 	void handleNatspec(bool _natspecDev, std::string const& _contract);
 	void handleGasEstimation(std::string const& _contract);
+	void handleAllocationStatistics();
 	void handleFormal();
 	void handleStorageLayout(std::string const& _contract);
 
-	/// Fills @a m_sourceCodes initially and @a m_redirects.
+	/// Prints @a _errors using @a _formatter, limiting repeated warnings if requested.
+	void printErrors(langutil::SourceReferenceFormatter& _formatter, langutil::ErrorList const& _errors);
+
+	/// Fills @a m_sourceCodes or @a m_sourceFiles initially and @a m_redirects.
 	bool readInputFilesAndConfigureRemappings();
 	/// Tries to read from the file @a _input or interprets _input literally if that fails.
 	/// It then tries to parse the contents and appends to m_libraries.
@@ -106,8 +115,11 @@ private:
 
 	/// Compiler arguments variable map
 	boost::program_options::variables_map m_args;
-	/// map of input files to source code strings
+	/// map of input files to source code strings, only used by the modes that modify or
+	/// reinterpret the inputs (linking, assembly and AST import)
 	std::map<std::string, std::string> m_sourceCodes;
+	/// map of input files to their contents, mapped into memory where possible, for compilation
+	std::map<std::string, std::shared_ptr<util::MappedFile const>> m_sourceFiles;
 	/// list of remappings
 	std::vector<frontend::CompilerStack::Remapping> m_remappings;
 	/// list of allowed directories to read files from
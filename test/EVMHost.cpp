@@ -22,6 +22,7 @@
 #include <test/EVMHost.h>
 
 #include <test/evmc/loader.h>
+#include <test/tools/evmInterpreter/EVMInterpreter.h>
 
 #include <libevmasm/GasMeter.h>
 
@@ -36,6 +37,11 @@ using namespace solidity::util;
 using namespace solidity::test;
 using namespace evmc::literals;
 
+namespace
+{
+bool s_builtinVM = false;
+}
+
 evmc::VM& EVMHost::getVM(string const& _path)
 {
 	static evmc::VM theVM;
@@ -58,18 +64,24 @@ evmc::VM& EVMHost::getVM(string const& _path)
 			cerr << endl;
 		}
 	}
+	if (!theVM)
+	{
+		theVM = evmc::VM{EVMInterpreter::create()};
+		s_builtinVM = true;
+	}
 	return theVM;
 }
 
+bool EVMHost::isBuiltinVM()
+{
+	return s_builtinVM;
+}
+
 EVMHost::EVMHost(langutil::EVMVersion _evmVersion, evmc::VM& _vm):
 	m_vm(_vm),
 	m_evmVersion(_evmVersion)
 {
-	if (!m_vm)
-	{
-		cerr << "Unable to find evmone library" << endl;
-		assertThrow(false, Exception, "");
-	}
+	assertThrow(m_vm, Exception, "No EVM available.");
 
 	if (_evmVersion == langutil::EVMVersion::homestead())
 		m_evmRevision = EVMC_HOMESTEAD;
@@ -39,10 +39,12 @@ public:
 	using MockedHost::get_code_size;
 	using MockedHost::get_balance;
 
-	/// Tries to dynamically load libevmone. @returns nullptr on failure.
-	/// The path has to be provided for the first successful run and will be ignored
-	/// afterwards.
+	/// Tries to dynamically load libevmone and falls back to the built-in EVM interpreter
+	/// if no path is given or loading fails, so the returned VM is always usable.
+	/// The path has to be provided for the first run and will be ignored afterwards.
 	static evmc::VM& getVM(std::string const& _path = {});
+	/// @returns true if the VM returned by getVM is the built-in EVM interpreter.
+	static bool isBuiltinVM();
 
 	explicit EVMHost(langutil::EVMVersion _evmVersion, evmc::VM& _vm = getVM());
 
@@ -44,7 +44,6 @@ struct Testsuite
 	boost::filesystem::path const path;
 	boost::filesystem::path const subpath;
 	bool smt;
-	bool needsVM;
 	TestCase::TestCaseCreator testCaseCreator;
 };
 
@@ -52,21 +51,21 @@ struct Testsuite
 /// Array of testsuits that can be run interactively as well as automatically
 Testsuite const g_interactiveTestsuites[] = {
 /*
-	Title                   Path           Subpath                SMT   NeedsVM Creator function */
-	{"Ewasm Translation",   "libyul",      "ewasmTranslationTests",false,false, &yul::test::EwasmTranslationTest::create},
-	{"Yul Optimizer",       "libyul",      "yulOptimizerTests",   false, false, &yul::test::YulOptimizerTest::create},
-	{"Yul Interpreter",     "libyul",      "yulInterpreterTests", false, false, &yul::test::YulInterpreterTest::create},
-	{"Yul Object Compiler", "libyul",      "objectCompiler",      false, false, &yul::test::ObjectCompilerTest::create},
-	{"Function Side Effects","libyul",     "functionSideEffects", false, false, &yul::test::FunctionSideEffects::create},
-	{"Yul Syntax",          "libyul",      "yulSyntaxTests",      false, false, &yul::test::SyntaxTest::create},
-	{"Syntax",              "libsolidity", "syntaxTests",         false, false, &SyntaxTest::create},
-	{"Error Recovery",      "libsolidity", "errorRecoveryTests",  false, false, &SyntaxTest::createErrorRecovery},
-	{"Semantic",            "libsolidity", "semanticTests",       false, true,  &SemanticTest::create},
-	{"JSON AST",            "libsolidity", "ASTJSON",             false, false, &ASTJSONTest::create},
-	{"JSON ABI",            "libsolidity", "ABIJson",             false, false, &ABIJsonTest::create},
-	{"SMT Checker",         "libsolidity", "smtCheckerTests",     true,  false, &SMTCheckerTest::create},
-	{"SMT Checker JSON",    "libsolidity", "smtCheckerTestsJSON", true,  false, &SMTCheckerJSONTest::create},
-	{"Gas Estimates",       "libsolidity", "gasTests",            false, false, &GasTest::create}
+	Title                   Path           Subpath                SMT   Creator function */
+	{"Ewasm Translation",   "libyul",      "ewasmTranslationTests",false, &yul::test::EwasmTranslationTest::create},
+	{"Yul Optimizer",       "libyul",      "yulOptimizerTests",   false, &yul::test::YulOptimizerTest::create},
+	{"Yul Interpreter",     "libyul",      "yulInterpreterTests", false, &yul::test::YulInterpreterTest::create},
+	{"Yul Object Compiler", "libyul",      "objectCompiler",      false, &yul::test::ObjectCompilerTest::create},
+	{"Function Side Effects","libyul",     "functionSideEffects", false, &yul::test::FunctionSideEffects::create},
+	{"Yul Syntax",          "libyul",      "yulSyntaxTests",      false, &yul::test::SyntaxTest::create},
+	{"Syntax",              "libsolidity", "syntaxTests",         false, &SyntaxTest::create},
+	{"Error Recovery",      "libsolidity", "errorRecoveryTests",  false, &SyntaxTest::createErrorRecovery},
+	{"Semantic",            "libsolidity", "semanticTests",       false, &SemanticTest::create},
+	{"JSON AST",            "libsolidity", "ASTJSON",             false, &ASTJSONTest::create},
+	{"JSON ABI",            "libsolidity", "ABIJson",             false, &ABIJsonTest::create},
+	{"SMT Checker",         "libsolidity", "smtCheckerTests",     true,  &SMTCheckerTest::create},
+	{"SMT Checker JSON",    "libsolidity", "smtCheckerTestsJSON", true,  &SMTCheckerJSONTest::create},
+	{"Gas Estimates",       "libsolidity", "gasTests",            false, &GasTest::create}
 };
 
 }
@@ -141,13 +141,12 @@ test_suite* init_unit_test_suite( int /*argc*/, char* /*argv*/[] )
 
 	initializeOptions();
 
-	bool disableSemantics = !solidity::test::EVMHost::getVM(solidity::test::CommonOptions::get().evmonePath.string());
-	if (disableSemantics)
+	solidity::test::EVMHost::getVM(solidity::test::CommonOptions::get().evmonePath.string());
+	if (solidity::test::EVMHost::isBuiltinVM())
 	{
-		cout << "Unable to find " << solidity::test::evmoneFilename << ". Please provide the path using -- --evmonepath <path>." << endl;
-		cout << "You can download it at" << endl;
-		cout << solidity::test::evmoneDownloadLink << endl;
-		cout << endl << "--- SKIPPING ALL SEMANTICS TESTS ---" << endl << endl;
+		cout << "Unable to find " << solidity::test::evmoneFilename << ". Using the built-in EVM interpreter instead." << endl;
+		cout << "To run the tests on evmone, provide its path using -- --evmonepath <path>. You can download it at" << endl;
+		cout << solidity::test::evmoneDownloadLink << endl << endl;
 	}
 	// Include the interactive tests in the automatic tests as well
 	for (auto const& ts: g_interactiveTestsuites)
@@ -157,9 +156,6 @@ test_suite* init_unit_test_suite( int /*argc*/, char* /*argv*/[] )
 		if (ts.smt && options.disableSMT)
 			continue;
 
-		if (ts.needsVM && disableSemantics)
-			continue;
-
 		solAssert(registerTests(
 			master,
 			options.testPath / ts.path,
@@ -168,22 +164,6 @@ test_suite* init_unit_test_suite( int /*argc*/, char* /*argv*/[] )
 		) > 0, std::string("no ") + ts.title + " tests found");
 	}
 
-	if (disableSemantics)
-	{
-		for (auto suite: {
-			"ABIDecoderTest",
-			"ABIEncoderTest",
-			"SolidityAuctionRegistrar",
-			"SolidityFixedFeeRegistrar",
-			"SolidityWallet",
-			"GasMeterTests",
-			"GasCostTests",
-			"SolidityEndToEndTest",
-			"SolidityOptimizer"
-		})
-			removeTestSuite(suite);
-	}
-
 	if (solidity::test::CommonOptions::get().disableSMT)
 		removeTestSuite("SMTChecker");
 
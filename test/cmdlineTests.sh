@@ -122,6 +122,8 @@ function test_solc_behaviour()
     else
         sed -i.bak -e '/^Warning: This is a pre-release compiler version, please do not use it in production./d' "$stderr_path"
         sed -i.bak -e 's/\(^[ ]*auxdata: \)0x[0-9a-f]*$/\1AUXDATA REMOVED/' "$stdout_path"
+        # The allocation statistics depend on the platform and standard library.
+        sed -i.bak -E -e 's/^(   [a-zA-Z]+:[[:space:]]+)[0-9]+ allocations, [0-9]+ bytes allocated, [0-9]+ bytes peak$/\1N allocations, N bytes allocated, N bytes peak/' "$stdout_path"
         sed -i.bak -e 's/ Consider adding "pragma .*$//' "$stderr_path"
         # Remove trailing empty lines. Needs a line break to make OSX sed happy.
         sed -i.bak -e '1{/^$/d
@@ -436,4 +438,35 @@ SOLTMPDIR=$(mktemp -d)
 )
 rm -rf "$SOLTMPDIR"
 
+printTask "Testing the gas profiler..."
+SOLTMPDIR=$(mktemp -d)
+(
+    set -e
+    cd "$SOLTMPDIR"
+    GASPROFILER="$REPO_ROOT"/${SOLIDITY_BUILD_DIR}/test/tools/gasprofiler
+    # The value of the immutable is only inserted into the code at deployment.
+    echo 'pragma solidity >=0.0; contract C { uint immutable x; uint y; constructor() public { x = 7; } function f() public { y = x; } }' > c.sol
+    output=$("$GASPROFILER" c.sol --calldata 26121ff0)
+    if ! grep -q "  C\.f$" <<< "$output" || grep -q "<unknown code>" <<< "$output"
+    then
+        printError "Incorrect gas profile:"
+        echo "$output"
+        exit 1
+    fi
+
+    for args in "--value abc" "--constructor-args zz" "--calldata zz"
+    do
+        set +e
+        "$GASPROFILER" c.sol $args &>/dev/null
+        exitCode=$?
+        set -e
+        if [[ $exitCode != 1 ]]
+        then
+            printError "Incorrect exit code for $args. Expected 1 but got $exitCode."
+            exit 1
+        fi
+    done
+)
+rm -rf "$SOLTMPDIR"
+
 echo "Commandline tests successful."
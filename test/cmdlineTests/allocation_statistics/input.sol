@@ -0,0 +1,5 @@
+pragma solidity >=0.0;
+
+contract C {
+    function f() public pure returns (uint) { return 1; }
+}
@@ -25,8 +25,11 @@
 
 #include <test/Common.h>
 
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <fstream>
+
 namespace solidity::langutil::test
 {
 
@@ -47,6 +50,70 @@ BOOST_AUTO_TEST_CASE(test_fail)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(mapped_file)
+{
+	boost::filesystem::path const path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+	std::ofstream(path.string()) << "contract C {}";
+	auto file = util::MappedFile::open(path.string());
+	BOOST_REQUIRE(file);
+
+	CharStream source(file, "source");
+	CharStream const copy = source;
+	file.reset();
+	boost::filesystem::remove(path);
+
+	BOOST_CHECK(source.source() == "contract C {}");
+	BOOST_CHECK(copy.source().data() == source.source().data());
+	BOOST_CHECK('c' == source.get());
+	BOOST_CHECK('}' == source.setPosition(12));
+	BOOST_CHECK(!util::MappedFile::open(path.string()));
+}
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+	CharStream const defaultStream;
+	BOOST_CHECK(defaultStream.source().data());
+	BOOST_CHECK(defaultStream.isPastEndOfInput());
+	BOOST_CHECK('\0' == defaultStream.get());
+
+	boost::filesystem::path const path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+	std::ofstream{path.string()};
+	auto file = util::MappedFile::open(path.string());
+	boost::filesystem::remove(path);
+	BOOST_REQUIRE(file);
+	BOOST_CHECK(file->contents().data());
+
+	CharStream const source(file, "source");
+	BOOST_CHECK(source.source().empty());
+	BOOST_CHECK('\0' == source.get());
+	BOOST_CHECK('\0' == source.get(2));
+
+	CharStream const shortSource("ab", "source");
+	BOOST_CHECK('b' == shortSource.get(1));
+	BOOST_CHECK('\0' == shortSource.get(2));
+	BOOST_CHECK('\0' == shortSource.get(3));
+}
+
+BOOST_AUTO_TEST_CASE(line_column)
+{
+	CharStream const source("a\nbc\r\n\nd", "source");
+
+	BOOST_CHECK(source.translatePositionToLineColumn(0) == std::make_tuple(0, 0));
+	BOOST_CHECK(source.translatePositionToLineColumn(1) == std::make_tuple(0, 1));
+	BOOST_CHECK(source.translatePositionToLineColumn(2) == std::make_tuple(1, 0));
+	BOOST_CHECK(source.translatePositionToLineColumn(6) == std::make_tuple(2, 0));
+	BOOST_CHECK(source.translatePositionToLineColumn(7) == std::make_tuple(3, 0));
+	BOOST_CHECK(source.translatePositionToLineColumn(100) == std::make_tuple(3, 1));
+
+	BOOST_CHECK_EQUAL(source.lineAtPosition(0), "a");
+	// A position at a line break refers to the line it ends.
+	BOOST_CHECK_EQUAL(source.lineAtPosition(1), "a");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(3), "bc");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(5), "bc");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(6), "");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(8), "d");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,107 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the printing of lists of errors.
+ */
+
+#include <liblangutil/SourceReferenceFormatter.h>
+#include <liblangutil/SourceReferenceFormatterHuman.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::langutil::test
+{
+
+namespace
+{
+
+shared_ptr<Error const> makeError(Error::Type _type, SourceLocation const& _location, string const& _message)
+{
+	return make_shared<Error>(_type, _location, _message);
+}
+
+ErrorList errors()
+{
+	auto const source = make_shared<CharStream>("contract C {\n\tuint x;\n\tuint y;\n}\n", "source");
+	return {
+		makeError(Error::Type::Warning, {14, 20, source}, "Unused."),
+		makeError(Error::Type::Warning, {23, 29, source}, "Unused."),
+		makeError(Error::Type::Warning, {23, 29, source}, "Unused."),
+		makeError(Error::Type::TypeError, {0, 8, source}, "Invalid."),
+		makeError(Error::Type::Warning, {23, 29, source}, "Other.")
+	};
+}
+
+string printIndividually(ErrorList const& _errors)
+{
+	ostringstream output;
+	SourceReferenceFormatterHuman formatter(output, false);
+	for (auto const& error: _errors)
+		formatter.printErrorInformation(*error);
+	return output.str();
+}
+
+string printList(ErrorList const& _errors, bool _deduplicate = false, optional<size_t> _maxRepeatedWarnings = nullopt)
+{
+	ostringstream output;
+	SourceReferenceFormatterHuman formatter(output, false);
+	formatter.printErrorInformation(_errors, _deduplicate, _maxRepeatedWarnings);
+	return output.str();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SourceReferenceFormatterTest)
+
+BOOST_AUTO_TEST_CASE(same_output_by_default)
+{
+	ErrorList const list = errors();
+	BOOST_CHECK_EQUAL(printList(list), printIndividually(list));
+	BOOST_CHECK_EQUAL(printList(list, false, 3), printIndividually(list));
+}
+
+BOOST_AUTO_TEST_CASE(deduplicate)
+{
+	ErrorList const list = errors();
+	BOOST_CHECK_EQUAL(printList(list, true), printIndividually({list[0], list[1], list[3], list[4]}));
+}
+
+BOOST_AUTO_TEST_CASE(max_repeated_warnings)
+{
+	ErrorList const list = errors();
+	Error summary(Error::Type::Warning, "2 further warnings with the following message were omitted: Unused.");
+	BOOST_CHECK_EQUAL(
+		printList(list, false, 1),
+		printIndividually({list[0], list[3], list[4]}) +
+		SourceReferenceFormatterHuman::formatExceptionInformation(summary, "Warning")
+	);
+	// Duplicates are removed before counting.
+	summary = Error(Error::Type::Warning, "1 further warning with the following message was omitted: Unused.");
+	BOOST_CHECK_EQUAL(
+		printList(list, true, 1),
+		printIndividually({list[0], list[3], list[4]}) +
+		SourceReferenceFormatterHuman::formatExceptionInformation(summary, "Warning")
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,172 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for running several analysis steps in a single traversal.
+ */
+
+#include <libsolidity/analysis/FusedAnalysis.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/parsing/Parser.h>
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Scanner.h>
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// Records the contracts and functions it visits and reports a warning for each function.
+class FunctionRecorder: private ASTConstVisitor, public FusableAnalysis
+{
+public:
+	FunctionRecorder(
+		ErrorReporter& _errorReporter,
+		string _name,
+		string _skippedContract = "",
+		string _fatalFunction = ""
+	):
+		m_errorReporter(_errorReporter),
+		m_name(move(_name)),
+		m_skippedContract(move(_skippedContract)),
+		m_fatalFunction(move(_fatalFunction))
+	{}
+
+	bool endSourceUnit(SourceUnit const&) override { return !m_errorReporter.hasErrors(); }
+	ASTConstVisitor& visitor() override { return *this; }
+
+	vector<string> events;
+
+private:
+	bool visit(ContractDefinition const& _contract) override
+	{
+		events.push_back("contract " + _contract.name());
+		return _contract.name() != m_skippedContract;
+	}
+	void endVisit(ContractDefinition const& _contract) override
+	{
+		events.push_back("end " + _contract.name());
+	}
+	bool visit(FunctionDefinition const& _function) override
+	{
+		events.push_back("function " + _function.name());
+		if (_function.name() == m_fatalFunction)
+			m_errorReporter.fatalTypeError(_function.location(), m_name + " failed at " + _function.name());
+		m_errorReporter.warning(_function.location(), m_name + " saw " + _function.name());
+		return true;
+	}
+
+	ErrorReporter& m_errorReporter;
+	string m_name;
+	string m_skippedContract;
+	string m_fatalFunction;
+};
+
+ASTPointer<SourceUnit> parseSource(string const& _source)
+{
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	ASTPointer<SourceUnit> sourceUnit = Parser(
+		errorReporter,
+		solidity::test::CommonOptions::get().evmVersion()
+	).parse(make_shared<Scanner>(CharStream(_source, "")));
+	BOOST_REQUIRE(sourceUnit && errors.empty());
+	return sourceUnit;
+}
+
+vector<string> messages(ErrorList const& _errors)
+{
+	vector<string> result;
+	for (auto const& error: _errors)
+		result.push_back(*error->comment());
+	return result;
+}
+
+string const c_source = R"(
+	contract A { function f() public {} function g() public {} }
+	contract B { function h() public {} }
+)";
+
+}
+
+BOOST_AUTO_TEST_SUITE(FusedAnalysisTest)
+
+BOOST_AUTO_TEST_CASE(errors_in_step_order)
+{
+	ASTPointer<SourceUnit> sourceUnit = parseSource(c_source);
+	FusedAnalysis analysis;
+	analysis.add<FunctionRecorder>("first");
+	analysis.add<FunctionRecorder>("second");
+
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	BOOST_CHECK(analysis.run({sourceUnit.get()}, errorReporter));
+	BOOST_CHECK(messages(errors) == (vector<string>{
+		"first saw f", "first saw g", "first saw h",
+		"second saw f", "second saw g", "second saw h"
+	}));
+}
+
+BOOST_AUTO_TEST_CASE(skipped_subtree)
+{
+	ASTPointer<SourceUnit> sourceUnit = parseSource(c_source);
+	FusedAnalysis analysis;
+	auto& skipping = analysis.add<FunctionRecorder>("skipping", "A");
+	auto& full = analysis.add<FunctionRecorder>("full");
+
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	BOOST_CHECK(analysis.run({sourceUnit.get()}, errorReporter));
+	BOOST_CHECK(skipping.events == (vector<string>{
+		"contract A", "end A", "contract B", "function h", "end B"
+	}));
+	BOOST_CHECK(full.events == (vector<string>{
+		"contract A", "function f", "function g", "end A", "contract B", "function h", "end B"
+	}));
+}
+
+BOOST_AUTO_TEST_CASE(fatal_error_drops_later_steps)
+{
+	ASTPointer<SourceUnit> sourceUnit = parseSource(c_source);
+	FusedAnalysis analysis;
+	analysis.add<FunctionRecorder>("first");
+	auto& failing = analysis.add<FunctionRecorder>("failing", "", "g");
+	auto& last = analysis.add<FunctionRecorder>("last");
+
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	BOOST_CHECK_THROW(analysis.run({sourceUnit.get()}, errorReporter), FatalError);
+	BOOST_CHECK(messages(errors) == (vector<string>{
+		"first saw f", "first saw g", "first saw h",
+		"failing saw f", "failing failed at g"
+	}));
+	BOOST_CHECK(failing.events == (vector<string>{"contract A", "function f", "function g"}));
+	BOOST_CHECK_EQUAL(last.events.size(), 7u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
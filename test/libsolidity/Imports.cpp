@@ -111,6 +111,19 @@ BOOST_AUTO_TEST_CASE(context_dependent_remappings_order_independent_2)
 	BOOST_CHECK(c.compile());
 }
 
+BOOST_AUTO_TEST_CASE(context_dependent_remappings_fall_back_to_shorter_context)
+{
+	CompilerStack c;
+	c.setRemappings(vector<CompilerStack::Remapping>{{"", "x", "d"}, {"a", "y", "e"}, {"", "x", "f"}});
+	c.setSources({
+		{"a/main.sol", "import \"x/z.sol\"; import \"y/z.sol\"; contract Main is F, E {} pragma solidity >=0.0;"},
+		{"f/z.sol", "contract F {} pragma solidity >=0.0;"},
+		{"e/z.sol", "contract E {} pragma solidity >=0.0;"}
+	});
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_CHECK(c.compile());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -19,8 +19,12 @@
  * Unit tests for libsolc/libsolc.cpp.
  */
 
+#include <fstream>
+#include <map>
 #include <string>
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
+#include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/Version.h>
@@ -178,6 +182,67 @@ BOOST_AUTO_TEST_CASE(with_callback)
 	BOOST_CHECK(containsError(result, "ParserError", "Source \"notfound.sol\" not found: Callback not supported."));
 }
 
+BOOST_AUTO_TEST_CASE(read_cache)
+{
+	boost::filesystem::path const directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+	BOOST_REQUIRE(boost::filesystem::create_directories(directory));
+	string const found = (directory / "found.sol").generic_string();
+	ofstream(found) << "contract B {}";
+	string const input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"fileA": {
+				"content": "import \")" + found + R"(\"; import \"virtual.sol\"; import \"notfound.sol\"; contract A is B, V { }"
+			}
+		}
+	}
+	)";
+
+	static map<string, unsigned> reads;
+	CStyleReadFileCallback callback{
+		[](void*, char const*, char const* _path, char** o_contents, char** o_error)
+		{
+			++reads[_path];
+			*o_error = nullptr;
+			if (string(_path) == "virtual.sol")
+				*o_contents = stringToSolidity("contract V {}");
+			else if (boost::filesystem::exists(_path))
+				*o_contents = stringToSolidity(util::readFileAsString(_path));
+			else
+				*o_contents = nullptr;
+		}
+	};
+
+	solidity_set_read_cache(true);
+	for (unsigned i = 0; i < 2; ++i)
+	{
+		Json::Value result = compile(input, callback);
+		BOOST_CHECK(containsError(result, "ParserError", "Source \"notfound.sol\" not found: Callback not supported."));
+	}
+	// Failed reads and files that are not in the local filesystem are not cached.
+	BOOST_CHECK_EQUAL(reads[found], 1);
+	BOOST_CHECK_EQUAL(reads["virtual.sol"], 2);
+	BOOST_CHECK_EQUAL(reads["notfound.sol"], 2);
+
+	// Changed files are read again without invalidating them.
+	ofstream(found) << "contract B { }";
+	compile(input, callback);
+	BOOST_CHECK_EQUAL(reads[found], 2);
+	compile(input, callback);
+	BOOST_CHECK_EQUAL(reads[found], 2);
+
+	solidity_invalidate_read_cache(found.c_str());
+	compile(input, callback);
+	BOOST_CHECK_EQUAL(reads[found], 3);
+
+	solidity_set_read_cache(false);
+	compile(input, callback);
+	BOOST_CHECK_EQUAL(reads[found], 4);
+
+	boost::filesystem::remove_all(directory);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
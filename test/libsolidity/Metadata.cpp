@@ -268,6 +268,8 @@ BOOST_AUTO_TEST_CASE(metadata_useLiteralContent)
 		Json::Value metadata;
 		util::jsonParseStrict(metadata_str, metadata);
 		BOOST_CHECK(solidity::test::isValidMetadata(metadata_str));
+		// The metadata is serialised in canonical form.
+		BOOST_CHECK_EQUAL(util::jsonCompactPrint(metadata), metadata_str);
 		BOOST_CHECK(metadata.isMember("settings"));
 		BOOST_CHECK(metadata["settings"].isMember("metadata"));
 		BOOST_CHECK(metadata["settings"]["metadata"].isMember("bytecodeHash"));
@@ -275,7 +277,10 @@ BOOST_AUTO_TEST_CASE(metadata_useLiteralContent)
 		{
 			BOOST_CHECK(metadata["settings"]["metadata"].isMember("useLiteralContent"));
 			BOOST_CHECK(metadata["settings"]["metadata"]["useLiteralContent"].asBool());
+			BOOST_CHECK_EQUAL(metadata["sources"][""]["content"].asString(), _src);
 		}
+		else
+			BOOST_CHECK_EQUAL(metadata["sources"][""]["urls"].size(), 2u);
 	};
 
 	check(sourceCode, true);
@@ -0,0 +1,135 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the cache of read callback responses.
+ */
+
+#include <libsolidity/interface/ReadCallbackCache.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <map>
+#include <optional>
+#include <string>
+
+using namespace std;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+string const c_readFile = ReadCallback::kindString(ReadCallback::Kind::ReadFile);
+
+string contents(ReadCallback::Result const& _result)
+{
+	BOOST_REQUIRE(_result.success);
+	return _result.file ? string(_result.file->contents()) : _result.responseOrErrorMessage;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ReadCallbackCacheTest)
+
+BOOST_AUTO_TEST_CASE(fingerprint)
+{
+	map<string, optional<string>> fingerprints{{"a.sol", "1"}, {"b.sol", nullopt}};
+	map<string, unsigned> reads;
+	ReadCallbackCache cache{[&](string const& _path) { return fingerprints[_path]; }};
+	ReadCallback::Callback read = cache.wrap([&](string const&, string const& _path) {
+		return ReadCallback::Result{true, _path + " " + to_string(++reads[_path])};
+	});
+
+	BOOST_CHECK_EQUAL(contents(read(c_readFile, "a.sol")), "a.sol 1");
+	BOOST_CHECK_EQUAL(contents(read(c_readFile, "a.sol")), "a.sol 1");
+	BOOST_CHECK_EQUAL(reads["a.sol"], 1u);
+	BOOST_CHECK_EQUAL(cache.size(), 1u);
+
+	// A changed fingerprint replaces the cached response.
+	fingerprints["a.sol"] = "2";
+	BOOST_CHECK_EQUAL(contents(read(c_readFile, "a.sol")), "a.sol 2");
+	BOOST_CHECK_EQUAL(contents(read(c_readFile, "a.sol")), "a.sol 2");
+	BOOST_CHECK_EQUAL(reads["a.sol"], 2u);
+	BOOST_CHECK_EQUAL(cache.size(), 1u);
+
+	// Files without fingerprint are always read and not cached.
+	BOOST_CHECK_EQUAL(contents(read(c_readFile, "b.sol")), "b.sol 1");
+	BOOST_CHECK_EQUAL(contents(read(c_readFile, "b.sol")), "b.sol 2");
+	BOOST_CHECK_EQUAL(cache.size(), 1u);
+
+	// Losing the fingerprint removes the cached response.
+	fingerprints["a.sol"] = nullopt;
+	BOOST_CHECK_EQUAL(contents(read(c_readFile, "a.sol")), "a.sol 3");
+	BOOST_CHECK_EQUAL(cache.size(), 0u);
+	fingerprints["a.sol"] = "2";
+	BOOST_CHECK_EQUAL(contents(read(c_readFile, "a.sol")), "a.sol 4");
+	BOOST_CHECK_EQUAL(cache.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(other_queries)
+{
+	unsigned reads = 0;
+	ReadCallbackCache cache;
+	ReadCallback::Callback read = cache.wrap([&](string const&, string const& _path) {
+		++reads;
+		return ReadCallback::Result{_path != "missing.sol", "response"};
+	});
+
+	string const smtQuery = ReadCallback::kindString(ReadCallback::Kind::SMTQuery);
+	read(smtQuery, "query");
+	read(smtQuery, "query");
+	read(c_readFile, "missing.sol");
+	read(c_readFile, "missing.sol");
+	BOOST_CHECK_EQUAL(reads, 4u);
+	BOOST_CHECK_EQUAL(cache.size(), 0u);
+
+	// Without a fingerprint function, responses stay valid until they are invalidated.
+	read(c_readFile, "a.sol");
+	read(c_readFile, "a.sol");
+	BOOST_CHECK_EQUAL(reads, 5u);
+	cache.invalidate("a.sol");
+	read(c_readFile, "a.sol");
+	BOOST_CHECK_EQUAL(reads, 6u);
+}
+
+BOOST_AUTO_TEST_CASE(file_fingerprint)
+{
+	boost::filesystem::path const directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+	BOOST_REQUIRE(boost::filesystem::create_directories(directory));
+	string const path = (directory / "a.sol").string();
+
+	BOOST_CHECK(!ReadCallbackCache::fileFingerprint(path));
+	BOOST_CHECK(!ReadCallbackCache::fileFingerprint(directory.string()));
+
+	ofstream(path) << "contract A {}";
+	optional<string> const fingerprint = ReadCallbackCache::fileFingerprint(path);
+	BOOST_REQUIRE(fingerprint);
+	BOOST_CHECK(ReadCallbackCache::fileFingerprint(path) == fingerprint);
+
+	ofstream(path) << "contract A { }";
+	BOOST_CHECK(ReadCallbackCache::fileFingerprint(path) != fingerprint);
+
+	boost::filesystem::remove_all(directory);
+	BOOST_CHECK(!ReadCallbackCache::fileFingerprint(path));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -19,10 +19,12 @@
  * Unit tests for interface/StandardCompiler.h.
  */
 
+#include <sstream>
 #include <string>
 #include <boost/test/unit_test.hpp>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
+#include <libsolutil/AllocationStatistics.h>
 #include <libsolutil/JSON.h>
 #include <test/Metadata.h>
 
@@ -1053,6 +1055,7 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["details"]["constantOptimizer"].asBool() == true);
 	BOOST_CHECK(optimizer["details"]["cse"].asBool() == false);
 	BOOST_CHECK(optimizer["details"]["deduplicate"].asBool() == true);
+	BOOST_CHECK(optimizer["details"]["jumpThreader"].asBool() == false);
 	BOOST_CHECK(optimizer["details"]["jumpdestRemover"].asBool() == true);
 	BOOST_CHECK(optimizer["details"]["orderLiterals"].asBool() == false);
 	BOOST_CHECK(optimizer["details"]["peephole"].asBool() == true);
@@ -1060,7 +1063,7 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["details"]["yulDetails"].isObject());
 	BOOST_CHECK(optimizer["details"]["yulDetails"].getMemberNames() == vector<string>{"stackAllocation"});
 	BOOST_CHECK(optimizer["details"]["yulDetails"]["stackAllocation"].asBool() == true);
-	BOOST_CHECK_EQUAL(optimizer["details"].getMemberNames().size(), 8);
+	BOOST_CHECK_EQUAL(optimizer["details"].getMemberNames().size(), 9);
 	BOOST_CHECK(optimizer["runs"].asUInt() == 600);
 }
 
@@ -1097,6 +1100,146 @@ BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 	BOOST_CHECK(solidity::test::isValidMetadata(contract["metadata"].asString()));
 }
 
+BOOST_AUTO_TEST_CASE(bytecode_only_for_selected_contracts)
+{
+	// NOTE: the code of contract A should fail to compile due to "out of stack".
+	// If no error is reported, code was only generated for B and the contract it creates.
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": {
+					"*": [ "abi" ],
+					"B": [ "evm.bytecode.object" ]
+				}
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A {
+  function x(uint a, uint b, uint c, uint d, uint e, uint f, uint g, uint h, uint i, uint j, uint k, uint l, uint m, uint n, uint o, uint p) pure public {}
+  function y() pure public {
+    uint a; uint b; uint c; uint d; uint e; uint f; uint g; uint h; uint i; uint j; uint k; uint l; uint m; uint n; uint o; uint p;
+    x(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p);
+  }
+}
+contract C { }
+contract B { function f() public { new C(); } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(contract["abi"].isArray());
+	BOOST_CHECK(!contract.isMember("evm"));
+	contract = getContractResult(result, "fileA", "C");
+	BOOST_CHECK(contract["abi"].isArray());
+	BOOST_CHECK(!contract.isMember("evm"));
+	contract = getContractResult(result, "fileA", "B");
+	BOOST_CHECK(contract["abi"].isArray());
+	BOOST_CHECK(contract["evm"]["bytecode"]["object"].isString());
+	BOOST_CHECK(!contract["evm"]["bytecode"]["object"].asString().empty());
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output_matches_json_output)
+{
+	// The source names are chosen so that "a.sol:..." sorts before "a:..."
+	// but "a" sorts before "a.sol".
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"*": {
+					"*": [ "abi", "evm.bytecode.object", "evm.legacyAssembly" ],
+					"": [ "ast" ]
+				}
+			}
+		},
+		"sources": {
+			"a": {
+				"content": "contract B { function f() public {} } contract A { }"
+			},
+			"a.sol": {
+				"content": "import \"a\"; contract C is B { }"
+			},
+			"b": {
+				"content": "interface I { function f() external; }"
+			}
+		}
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	frontend::StandardCompiler compiler;
+	string const expectation = util::jsonCompactPrint(compiler.compile(parsedInput));
+	ostringstream streamed;
+	compiler.compile(input, streamed);
+	BOOST_CHECK_EQUAL(streamed.str(), expectation);
+
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(getContractResult(result, "a", "B")["evm"]["bytecode"]["object"].isString());
+	BOOST_CHECK(getContractResult(result, "a.sol", "C")["abi"].isArray());
+	BOOST_CHECK(result["sources"]["b"]["ast"].isObject());
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output_interrupted_after_errors)
+{
+	/// Fails once the output reaches the given text.
+	class FailingBuffer: public stringbuf
+	{
+	public:
+		explicit FailingBuffer(string _failAt): m_failAt(move(_failAt)) {}
+	protected:
+		streamsize xsputn(char const* _data, streamsize _size) override
+		{
+			streamsize const written = stringbuf::xsputn(_data, _size);
+			if (str().find(m_failAt) != string::npos)
+				throw runtime_error("Write failed.");
+			return written;
+		}
+		int_type overflow(int_type _char) override
+		{
+			int_type const result = stringbuf::overflow(_char);
+			if (str().find(m_failAt) != string::npos)
+				throw runtime_error("Write failed.");
+			return result;
+		}
+	private:
+		string m_failAt;
+	};
+
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"*": { "*": [ "abi" ], "": [ "ast" ] }
+			}
+		},
+		"sources": {
+			"A": { "content": "pragma solidity >=0.0; contract A { function f() public {} }" }
+		}
+	}
+	)";
+	FailingBuffer buffer("\"sources\"");
+	ostream output(&buffer);
+	output.exceptions(ios::badbit);
+	frontend::StandardCompiler().compile(input, output);
+
+	// The contracts have been written, but the output must not be mistaken for a complete result.
+	string const result = buffer.str();
+	BOOST_CHECK(result.find("\"contracts\"") != string::npos);
+	Json::Value parsed;
+	BOOST_CHECK(!util::jsonParseStrict(result, parsed));
+}
+
 BOOST_AUTO_TEST_CASE(common_pattern)
 {
 	char const* input = R"(
@@ -1363,6 +1506,61 @@ BOOST_AUTO_TEST_CASE(standard_output_selection_wildcard_multiple_sources)
 	BOOST_REQUIRE(result["sources"]["B"].isObject());
 }
 
+BOOST_AUTO_TEST_CASE(allocation_statistics_not_boolean)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"debug": {
+				"allocationStatistics": "yes"
+			}
+		},
+		"sources": {
+			"empty": {
+				"content": ""
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "settings.debug.allocationStatistics must be a Boolean."));
+}
+
+BOOST_AUTO_TEST_CASE(allocation_statistics)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"debug": {
+				"allocationStatistics": true
+			},
+			"outputSelection": {
+				"*": { "*": ["evm.bytecode.object"] }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() public pure {} }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	if (util::AllocationStatistics::available())
+	{
+		Json::Value const& statistics = result["debug"]["allocationStatistics"];
+		BOOST_REQUIRE(statistics.isObject());
+		BOOST_CHECK(statistics["allocations"].asUInt64() > 0);
+		BOOST_CHECK(statistics["phases"]["parsing"].isObject());
+		BOOST_CHECK(statistics["contracts"]["fileA:A"]["codegen"].isObject());
+	}
+	else
+		BOOST_CHECK(containsError(result, "JSONError", "Allocation statistics are not available in this build of the compiler."));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
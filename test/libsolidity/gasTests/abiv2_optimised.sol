@@ -17,13 +17,13 @@ contract C {
 // optimize-yul: true
 // ----
 // creation:
-//   codeDepositCost: 603000
-//   executionCost: 638
-//   totalCost: 603638
+//   codeDepositCost: 593600
+//   executionCost: 625
+//   totalCost: 594225
 // external:
-//   a(): 1029
-//   b(uint256): 2084
-//   f1(uint256): 351
+//   a(): 997
+//   b(uint256): 2052
+//   f1(uint256): 319
 //   f2(uint256[],string[],uint16,address): infinite
 //   f3(uint16[],string[],uint16,address): infinite
 //   f4(uint32[],string[12],bytes[2][],address): infinite
@@ -0,0 +1,31 @@
+pragma experimental ABIEncoderV2;
+
+contract C {
+    function id(bytes memory a) public pure returns (bytes memory) {
+        return a;
+    }
+    function check(uint n) public view returns (bool) {
+        bytes memory a = new bytes(n);
+        for (uint i = 0; i < n; i++)
+            a[i] = byte(uint8(i * 7 + 3));
+        bytes memory b = this.id(a);
+        bytes memory c = abi.encodePacked(a, a);
+        if (b.length != n || c.length != 2 * n)
+            return false;
+        for (uint i = 0; i < n; i++)
+            if (b[i] != a[i] || c[i] != a[i] || c[n + i] != a[i])
+                return false;
+        return true;
+    }
+}
+// ====
+// EVMVersion: >=byzantium
+// ----
+// check(uint256): 0 -> true
+// check(uint256): 31 -> true
+// check(uint256): 33 -> true
+// check(uint256): 351 -> true
+// check(uint256): 352 -> true
+// check(uint256): 353 -> true
+// check(uint256): 1000 -> true
+// check(uint256): 4097 -> true
@@ -0,0 +1,26 @@
+pragma experimental ABIEncoderV2;
+
+contract C {
+    function check(uint n) public pure returns (bool) {
+        bytes memory a = new bytes(n);
+        for (uint i = 0; i < n; i++)
+            a[i] = byte(uint8(i * 7 + 3));
+        bytes memory c = abi.encodePacked(a, a);
+        if (c.length != 2 * n)
+            return false;
+        for (uint i = 0; i < n; i++)
+            if (c[i] != a[i] || c[n + i] != a[i])
+                return false;
+        return true;
+    }
+}
+// ----
+// check(uint256): 0 -> true
+// check(uint256): 31 -> true
+// check(uint256): 63 -> true
+// check(uint256): 64 -> true
+// check(uint256): 65 -> true
+// check(uint256): 351 -> true
+// check(uint256): 352 -> true
+// check(uint256): 1000 -> true
+// check(uint256): 4097 -> true
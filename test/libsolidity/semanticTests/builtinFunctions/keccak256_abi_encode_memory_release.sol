@@ -0,0 +1,22 @@
+contract C {
+    function f(uint256 n) public pure returns (bytes32 h, uint256 memoryGrowth) {
+        uint256 freeMemoryBefore;
+        assembly { freeMemoryBefore := mload(0x40) }
+        for (uint256 i = 0; i < n; i++)
+            h = keccak256(abi.encodePacked(h, i));
+        uint256 freeMemoryAfter;
+        assembly { freeMemoryAfter := mload(0x40) }
+        memoryGrowth = freeMemoryAfter - freeMemoryBefore;
+    }
+    function g(uint256 a) public pure returns (bool, bytes memory) {
+        bytes memory x = abi.encodePacked(uint8(1), uint8(2));
+        bytes32 h = keccak256(abi.encodeWithSignature("f(uint256,string)", a, "abc"));
+        bytes memory y = abi.encodePacked(uint8(3));
+        return (h == keccak256(abi.encodePacked(bytes4(keccak256("f(uint256,string)")), abi.encode(a, "abc"))), abi.encodePacked(x, y));
+    }
+}
+// ----
+// f(uint256): 0 -> 0, 0
+// f(uint256): 1 -> 0xad3228b676f7d3cd4284a5443f17f1962b36e491b30a40b2405849e597ba5fb5, 0
+// f(uint256): 3 -> 0xb1dfe1675e1f3e50621a30de3c781878e545b811232bc4a29662d8e021a43bc4, 0
+// g(uint256): 7 -> true, 0x40, 3, 0x0102030000000000000000000000000000000000000000000000000000000000
@@ -0,0 +1,20 @@
+contract C {
+    function g() public pure returns (uint256) {
+        return 7;
+    }
+    function f(uint256 offset, uint256 size) public returns (uint256 r) {
+        (bool success,) = address(this).call(abi.encodeWithSignature("g()"));
+        require(success);
+        assembly {
+            returndatacopy(0, offset, size)
+            r := mload(0)
+        }
+    }
+}
+// ====
+// EVMVersion: >=byzantium
+// ----
+// f(uint256,uint256): 0, 32 -> 7
+// f(uint256,uint256): 1, 32 -> FAILURE
+// f(uint256,uint256): 33, 0 -> FAILURE
+// f(uint256,uint256): -1, 2 -> FAILURE
@@ -0,0 +1,31 @@
+contract C {
+    uint64 a;
+    uint64 b;
+    uint128 c;
+
+    function set(uint64 x, uint64 y, uint128 z) public {
+        a = x;
+        b = y;
+        c = z;
+    }
+
+    function setSame(uint64 x) public {
+        b = x;
+        b = x + 1;
+    }
+
+    function get() public view returns (uint64, uint64, uint128) {
+        return (a, b, c);
+    }
+}
+
+// ====
+// compileViaYul: also
+// ----
+// get() -> 0, 0, 0
+// set(uint64,uint64,uint128): 1, 2, 3 ->
+// get() -> 1, 2, 3
+// setSame(uint64): 7 ->
+// get() -> 1, 8, 3
+// set(uint64,uint64,uint128): 0xffffffffffffffff, 0, 0xffffffffffffffffffffffffffffffff ->
+// get() -> 0xffffffffffffffff, 0, 0xffffffffffffffffffffffffffffffff
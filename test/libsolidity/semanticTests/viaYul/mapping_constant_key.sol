@@ -0,0 +1,20 @@
+contract C {
+    mapping(uint256 => uint256) m;
+    mapping(uint256 => mapping(uint256 => uint256)) n;
+    function set(uint256 k, uint256 v) public {
+        m[k] = v;
+        n[k][7] = v + 1;
+    }
+    function get() public returns (uint256, uint256) {
+        m[3] = m[3] + 1;
+        return (m[3], n[3][7]);
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// get() -> 1, 0
+// set(uint256,uint256): 3, 0x10 ->
+// get() -> 0x11, 0x11
+// set(uint256,uint256): 2, 0x20 ->
+// get() -> 0x12, 0x11
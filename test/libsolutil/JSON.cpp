@@ -25,6 +25,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <sstream>
+
 using namespace std;
 
 namespace solidity::util::test
@@ -69,6 +71,38 @@ BOOST_AUTO_TEST_CASE(json_compact_print)
 	BOOST_CHECK("{\"1\":1,\"2\":\"2\",\"3\":{\"3.1\":\"3.1\",\"3.2\":2}}" == jsonCompactPrint(json));
 }
 
+BOOST_AUTO_TEST_CASE(json_compact_stream_writer)
+{
+	Json::Value json;
+	json["1"] = 1;
+	json["2"]["2.1"] = "2.1";
+	json["2"]["2.2"]["x"] = Json::arrayValue;
+	json["3\""] = Json::objectValue;
+
+	ostringstream stream;
+	JsonCompactStreamWriter writer(stream);
+	BOOST_CHECK(writer.empty());
+	writer.member("1", 1);
+	writer.beginObject("2");
+	writer.member("2.1", "2.1");
+	writer.beginObject("2.2");
+	writer.member("x", Json::arrayValue);
+	BOOST_CHECK_EQUAL(writer.depth(), 3);
+	writer.endObject();
+	BOOST_CHECK(writer.lastKey() == string("2.2"));
+	writer.endObject();
+	writer.beginObject("3\"");
+	writer.finish();
+	BOOST_CHECK(!writer.empty());
+	BOOST_CHECK_EQUAL(writer.depth(), 0);
+	BOOST_CHECK_EQUAL(stream.str(), jsonCompactPrint(json));
+
+	ostringstream emptyStream;
+	JsonCompactStreamWriter emptyWriter(emptyStream);
+	emptyWriter.finish();
+	BOOST_CHECK_EQUAL(emptyStream.str(), "{}");
+}
+
 BOOST_AUTO_TEST_CASE(parse_json_strict)
 {
 	Json::Value json;
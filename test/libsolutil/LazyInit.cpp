@@ -0,0 +1,78 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for values that are computed on first access.
+ */
+
+#include <libsolutil/LazyInit.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(LazyInitTest)
+
+BOOST_AUTO_TEST_CASE(computed_once)
+{
+	LazyInit<string> value;
+	unsigned computations = 0;
+	auto compute = [&]() { ++computations; return string("x"); };
+	BOOST_CHECK_EQUAL(value.init(compute), "x");
+	BOOST_CHECK_EQUAL(&value.init(compute), &value.init(compute));
+	BOOST_CHECK_EQUAL(computations, 1);
+}
+
+BOOST_AUTO_TEST_CASE(retry_after_exception)
+{
+	LazyInit<int> value;
+	BOOST_CHECK_THROW(value.init([]() -> int { throw runtime_error("failed"); }), runtime_error);
+	BOOST_CHECK_EQUAL(value.init([]() { return 7; }), 7);
+	BOOST_CHECK_EQUAL(value.init([]() { return 8; }), 7);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_access)
+{
+	LazyInit<int> value;
+	atomic<unsigned> computations{0};
+	vector<int const*> results(8, nullptr);
+	vector<thread> threads;
+	for (size_t i = 0; i < results.size(); ++i)
+		threads.emplace_back([&, i]() {
+			results[i] = &value.init([&]() { ++computations; return 42; });
+		});
+	for (auto& t: threads)
+		t.join();
+	BOOST_CHECK_EQUAL(computations.load(), 1);
+	for (int const* result: results)
+		BOOST_CHECK(result == &value.init([]() { return 0; }));
+	BOOST_CHECK_EQUAL(value.init([]() { return 0; }), 42);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -26,6 +26,7 @@
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/ControlFlowSimplifier.h>
 #include <libyul/optimiser/DeadCodeEliminator.h>
+#include <libyul/optimiser/DeadStoreEliminator.h>
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/CircularReferencesPruner.h>
@@ -37,6 +38,7 @@
 #include <libyul/optimiser/ExpressionSplitter.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/FunctionHoister.h>
+#include <libyul/optimiser/FunctionSpecializer.h>
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
@@ -44,6 +46,7 @@
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopUnroller.h>
 #include <libyul/optimiser/MainFunction.h>
 #include <libyul/optimiser/NameDisplacer.h>
 #include <libyul/optimiser/Rematerialiser.h>
@@ -54,9 +57,11 @@
 #include <libyul/optimiser/SSAReverser.h>
 #include <libyul/optimiser/SSATransform.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/RangeSimplifier.h>
 #include <libyul/optimiser/RedundantAssignEliminator.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
 #include <libyul/optimiser/StackCompressor.h>
+#include <libyul/optimiser/StrengthReducer.h>
 #include <libyul/optimiser/Suite.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
 #include <libyul/backends/evm/EVMDialect.h>
@@ -202,6 +207,14 @@ TestCase::TestResult YulOptimizerTest::run(ostream& _stream, string const& _line
 		FullInliner::run(*m_context, *m_ast);
 		ExpressionJoiner::run(*m_context, *m_ast);
 	}
+	else if (m_optimizerStep == "functionSpecializer")
+	{
+		disambiguate();
+		FunctionHoister::run(*m_context, *m_ast);
+		FunctionGrouper::run(*m_context, *m_ast);
+		ForLoopInitRewriter::run(*m_context, *m_ast);
+		FunctionSpecializer::run(*m_context, *m_ast);
+	}
 	else if (m_optimizerStep == "mainFunction")
 	{
 		disambiguate();
@@ -280,12 +293,37 @@ TestCase::TestResult YulOptimizerTest::run(ostream& _stream, string const& _line
 		ExpressionJoiner::run(*m_context, *m_ast);
 		ExpressionJoiner::run(*m_context, *m_ast);
 	}
+	else if (m_optimizerStep == "deadStoreEliminator")
+	{
+		disambiguate();
+		ForLoopInitRewriter::run(*m_context, *m_ast);
+		DeadStoreEliminator::run(*m_context, *m_ast);
+	}
+	else if (m_optimizerStep == "rangeSimplifier")
+	{
+		disambiguate();
+		ForLoopInitRewriter::run(*m_context, *m_ast);
+		RangeSimplifier::run(*m_context, *m_ast);
+	}
 	else if (m_optimizerStep == "loopInvariantCodeMotion")
 	{
 		disambiguate();
 		ForLoopInitRewriter::run(*m_context, *m_ast);
 		LoopInvariantCodeMotion::run(*m_context, *m_ast);
 	}
+	else if (m_optimizerStep == "loopUnroller")
+	{
+		disambiguate();
+		FunctionHoister::run(*m_context, *m_ast);
+		ForLoopInitRewriter::run(*m_context, *m_ast);
+		LoopUnroller::run(*m_context, *m_ast);
+	}
+	else if (m_optimizerStep == "strengthReducer")
+	{
+		disambiguate();
+		ForLoopInitRewriter::run(*m_context, *m_ast);
+		StrengthReducer::run(*m_context, *m_ast);
+	}
 	else if (m_optimizerStep == "controlFlowSimplifier")
 	{
 		disambiguate();
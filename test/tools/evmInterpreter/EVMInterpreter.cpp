@@ -0,0 +1,1102 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * EVM bytecode interpreter implementing the EVMC VM interface.
+ */
+
+#include <test/tools/evmInterpreter/EVMInterpreter.h>
+
+#include <test/evmc/evmc.hpp>
+
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/Common.h>
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
+
+#include <array>
+#include <cstring>
+#include <limits>
+#include <optional>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::evmasm;
+using namespace solidity::test;
+
+namespace
+{
+
+using u512 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<512, 256, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>>;
+
+/// Upper bound for the size of memory and of the ranges accessed in call data, code and
+/// return data. Anything larger costs more gas than any block provides.
+uint64_t constexpr c_maxBufferSize = numeric_limits<uint32_t>::max();
+size_t constexpr c_stackLimit = 1024;
+int32_t constexpr c_callDepthLimit = 1024;
+
+u256 fromEVMC(evmc_bytes32 const& _value)
+{
+	u256 result;
+	for (uint8_t byte: _value.bytes)
+		result = (result << 8) | byte;
+	return result;
+}
+
+u256 fromEVMC(evmc_address const& _address)
+{
+	u256 result;
+	for (uint8_t byte: _address.bytes)
+		result = (result << 8) | byte;
+	return result;
+}
+
+evmc::bytes32 toBytes32(u256 _value)
+{
+	evmc::bytes32 result;
+	for (size_t i = 32; i > 0; --i, _value >>= 8)
+		result.bytes[i - 1] = uint8_t(_value & 0xff);
+	return result;
+}
+
+evmc::address toAddress(u256 _value)
+{
+	evmc::address result;
+	for (size_t i = 20; i > 0; --i, _value >>= 8)
+		result.bytes[i - 1] = uint8_t(_value & 0xff);
+	return result;
+}
+
+int64_t toGas(u256 const& _value)
+{
+	return _value > u256(numeric_limits<int64_t>::max()) ? numeric_limits<int64_t>::max() : int64_t(_value);
+}
+
+uint64_t numWords(uint64_t _size)
+{
+	return (_size + 31) / 32;
+}
+
+/// Static properties of an opcode for a specific EVM revision.
+struct OpcodeInfo
+{
+	bool defined = false;
+	unsigned args = 0;
+	unsigned ret = 0;
+	/// Gas charged before execution. Costs that depend on the arguments
+	/// or on the state are charged while executing the instruction.
+	int64_t baseGas = 0;
+};
+
+using OpcodeTable = array<OpcodeInfo, 256>;
+
+int64_t baseGas(Instruction _instruction, langutil::EVMVersion _evmVersion)
+{
+	switch (_instruction)
+	{
+	case Instruction::EXP:
+		return GasCosts::expGas;
+	case Instruction::KECCAK256:
+		return GasCosts::keccak256Gas;
+	case Instruction::BALANCE:
+		return GasCosts::balanceGas(_evmVersion);
+	case Instruction::EXTCODESIZE:
+	case Instruction::EXTCODECOPY:
+		return GasCosts::extCodeGas(_evmVersion);
+	case Instruction::EXTCODEHASH:
+		return _evmVersion >= langutil::EVMVersion::istanbul() ? 700 : 400;
+	case Instruction::SLOAD:
+		return GasCosts::sloadGas(_evmVersion);
+	case Instruction::SSTORE:
+		return 0;
+	case Instruction::JUMPDEST:
+		return GasCosts::jumpdestGas;
+	case Instruction::LOG0:
+	case Instruction::LOG1:
+	case Instruction::LOG2:
+	case Instruction::LOG3:
+	case Instruction::LOG4:
+		return
+			GasCosts::logGas +
+			GasCosts::logTopicGas * (unsigned(_instruction) - unsigned(Instruction::LOG0));
+	case Instruction::CREATE:
+	case Instruction::CREATE2:
+		return GasCosts::createGas;
+	case Instruction::CALL:
+	case Instruction::CALLCODE:
+	case Instruction::DELEGATECALL:
+	case Instruction::STATICCALL:
+		return GasCosts::callGas(_evmVersion);
+	case Instruction::SELFDESTRUCT:
+		return GasCosts::selfdestructGas(_evmVersion);
+	default:
+		return GasMeter::runGas(_instruction);
+	}
+}
+
+OpcodeTable const& opcodeTable(evmc_revision _revision)
+{
+	static array<unique_ptr<OpcodeTable>, EVMC_MAX_REVISION + 1> tables;
+	auto& table = tables.at(_revision);
+	if (!table)
+	{
+		langutil::EVMVersion evmVersion = EVMInterpreter::evmVersion(_revision);
+		table = make_unique<OpcodeTable>();
+		for (unsigned opcode = 0; opcode < 256; ++opcode)
+		{
+			auto instruction = Instruction(opcode);
+			if (!isValidInstruction(instruction) || !evmVersion.hasOpcode(instruction))
+				continue;
+			if (instruction == Instruction::REVERT && !evmVersion.supportsReturndata())
+				continue;
+			InstructionInfo info = instructionInfo(instruction);
+			if (info.gasPriceTier == Tier::Invalid)
+				continue;
+			OpcodeInfo& entry = (*table)[opcode];
+			entry.defined = true;
+			entry.args = unsigned(info.args);
+			entry.ret = unsigned(info.ret);
+			entry.baseGas = baseGas(instruction, evmVersion);
+		}
+	}
+	return *table;
+}
+
+/**
+ * VM instance, optionally carrying a tracer.
+ */
+struct InterpreterVM: evmc_vm
+{
+	EVMTracer* tracer = nullptr;
+};
+
+/**
+ * Execution of a single call frame.
+ */
+class Execution
+{
+public:
+	Execution(
+		evmc::HostContext& _host,
+		evmc_revision _revision,
+		evmc_message const& _message,
+		uint8_t const* _code,
+		size_t _codeSize,
+		EVMTracer* _tracer
+	):
+		m_host(_host),
+		m_tracer(_tracer),
+		m_evmVersion(EVMInterpreter::evmVersion(_revision)),
+		m_opcodes(opcodeTable(_revision)),
+		m_message(_message),
+		m_code(_code),
+		m_codeSize(_codeSize),
+		m_gas(_message.gas)
+	{
+		m_stack.reserve(c_stackLimit);
+	}
+
+	evmc::result run();
+
+private:
+	/// Executes the instruction at the current program counter.
+	/// @returns a status code if execution has to stop.
+	optional<evmc_status_code> step();
+
+	evmc_status_code executeCall(Instruction _instruction);
+	evmc_status_code executeCreate(Instruction _instruction);
+	evmc_status_code executeStorageStore();
+	evmc_status_code executeSelfdestruct();
+
+	void analyzeJumpDestinations();
+	bool isValidJumpDestination(u256 const& _destination) const
+	{
+		return _destination < m_jumpDestinations.size() && m_jumpDestinations[size_t(_destination)];
+	}
+
+	u256 pop()
+	{
+		u256 value = std::move(m_stack.back());
+		m_stack.pop_back();
+		return value;
+	}
+	void push(u256 _value) { m_stack.emplace_back(std::move(_value)); }
+
+	/// Subtracts the given amount from the gas left. @returns false if there was not enough gas.
+	bool consumeGas(int64_t _amount)
+	{
+		m_gas -= _amount;
+		return m_gas >= 0;
+	}
+	/// Charges for memory expansion such that [_offset, _offset + _size) is accessible.
+	/// @returns false on out of gas.
+	bool expandMemory(u256 const& _offset, u256 const& _size);
+	/// Charges @a _gasPerWord for each (partial) word of @a _size. @returns false on out of gas.
+	bool consumeWordGas(u256 const& _size, unsigned _gasPerWord);
+	/// Copies the data at @a _sourceOffset in @a _source to memory at @a _memoryOffset,
+	/// filling with zeros beyond the end of the source. Memory has to be expanded already.
+	void copyToMemory(u256 const& _memoryOffset, uint8_t const* _source, size_t _sourceSize, u256 const& _sourceOffset, u256 const& _size);
+	/// @returns a pointer into memory, nullptr for empty ranges. Memory has to be expanded already.
+	uint8_t const* memoryPointer(u256 const& _offset, u256 const& _size) const
+	{
+		return _size == 0 ? nullptr : m_memory.data() + size_t(_offset);
+	}
+
+	evmc::HostContext& m_host;
+	EVMTracer* m_tracer;
+	langutil::EVMVersion m_evmVersion;
+	OpcodeTable const& m_opcodes;
+	evmc_message const& m_message;
+	uint8_t const* m_code;
+	size_t m_codeSize;
+
+	vector<bool> m_jumpDestinations;
+	vector<u256> m_stack;
+	bytes m_memory;
+	bytes m_returnData;
+	bytes m_output;
+	int64_t m_gas;
+	size_t m_pc = 0;
+};
+
+evmc::result Execution::run()
+{
+	analyzeJumpDestinations();
+
+	if (m_tracer)
+		m_tracer->enterFrame(m_message, bytesConstRef(m_code, m_codeSize));
+
+	evmc_status_code status = EVMC_SUCCESS;
+	while (m_pc < m_codeSize)
+	{
+		int64_t const gasBefore = m_gas;
+		if (m_tracer)
+			m_tracer->startInstruction(m_pc);
+		optional<evmc_status_code> stop = step();
+		if (m_tracer)
+		{
+			bool const keepsGas = !stop || *stop == EVMC_SUCCESS || *stop == EVMC_REVERT;
+			m_tracer->endInstruction(gasBefore - (keepsGas ? m_gas : 0));
+		}
+		if (stop)
+		{
+			status = *stop;
+			break;
+		}
+	}
+
+	if (m_tracer)
+		m_tracer->leaveFrame();
+
+	if (status == EVMC_SUCCESS || status == EVMC_REVERT)
+		return evmc::result(status, m_gas, m_output.data(), m_output.size());
+	else
+		return evmc::result(status, 0, nullptr, 0);
+}
+
+void Execution::analyzeJumpDestinations()
+{
+	m_jumpDestinations.assign(m_codeSize, false);
+	for (size_t i = 0; i < m_codeSize; ++i)
+	{
+		auto const opcode = m_code[i];
+		if (opcode == uint8_t(Instruction::JUMPDEST))
+			m_jumpDestinations[i] = true;
+		else if (opcode >= uint8_t(Instruction::PUSH1) && opcode <= uint8_t(Instruction::PUSH32))
+			i += size_t(opcode - uint8_t(Instruction::PUSH1) + 1);
+	}
+}
+
+bool Execution::expandMemory(u256 const& _offset, u256 const& _size)
+{
+	if (_size == 0)
+		return true;
+	if (_offset > c_maxBufferSize || _size > c_maxBufferSize)
+		return false;
+	uint64_t end = uint64_t(_offset) + uint64_t(_size);
+	if (end <= m_memory.size())
+		return true;
+
+	auto cost = [](uint64_t _words) {
+		return int64_t(_words * GasCosts::memoryGas + _words * _words / GasCosts::quadCoeffDiv);
+	};
+	uint64_t newWords = numWords(end);
+	if (!consumeGas(cost(newWords) - cost(m_memory.size() / 32)))
+		return false;
+	m_memory.resize(size_t(newWords * 32));
+	return true;
+}
+
+bool Execution::consumeWordGas(u256 const& _size, unsigned _gasPerWord)
+{
+	if (_size > c_maxBufferSize)
+		return false;
+	return consumeGas(int64_t(numWords(uint64_t(_size)) * _gasPerWord));
+}
+
+void Execution::copyToMemory(
+	u256 const& _memoryOffset,
+	uint8_t const* _source,
+	size_t _sourceSize,
+	u256 const& _sourceOffset,
+	u256 const& _size
+)
+{
+	if (_size == 0)
+		return;
+	uint8_t* target = m_memory.data() + size_t(_memoryOffset);
+	size_t size = size_t(_size);
+	size_t copySize = 0;
+	if (_sourceOffset < _sourceSize)
+	{
+		copySize = min(size, _sourceSize - size_t(_sourceOffset));
+		memcpy(target, _source + size_t(_sourceOffset), copySize);
+	}
+	memset(target + copySize, 0, size - copySize);
+}
+
+optional<evmc_status_code> Execution::step()
+{
+	uint8_t const opcode = m_code[m_pc];
+	OpcodeInfo const& info = m_opcodes[opcode];
+	if (!info.defined)
+		return opcode == uint8_t(Instruction::INVALID) ? EVMC_INVALID_INSTRUCTION : EVMC_UNDEFINED_INSTRUCTION;
+	if (m_stack.size() < info.args)
+		return EVMC_STACK_UNDERFLOW;
+	if (m_stack.size() - info.args + info.ret > c_stackLimit)
+		return EVMC_STACK_OVERFLOW;
+	if (!consumeGas(info.baseGas))
+		return EVMC_OUT_OF_GAS;
+
+	auto const instruction = Instruction(opcode);
+	if (instruction >= Instruction::PUSH1 && instruction <= Instruction::PUSH32)
+	{
+		size_t const length = size_t(opcode - uint8_t(Instruction::PUSH1) + 1);
+		u256 value;
+		for (size_t i = 1; i <= length; ++i)
+			value = (value << 8) | (m_pc + i < m_codeSize ? m_code[m_pc + i] : 0);
+		push(std::move(value));
+		m_pc += length + 1;
+		return nullopt;
+	}
+	else if (instruction >= Instruction::DUP1 && instruction <= Instruction::DUP16)
+	{
+		push(m_stack[m_stack.size() - 1 - size_t(opcode - uint8_t(Instruction::DUP1))]);
+		++m_pc;
+		return nullopt;
+	}
+	else if (instruction >= Instruction::SWAP1 && instruction <= Instruction::SWAP16)
+	{
+		swap(m_stack.back(), m_stack[m_stack.size() - 2 - size_t(opcode - uint8_t(Instruction::SWAP1))]);
+		++m_pc;
+		return nullopt;
+	}
+
+	bool const isStatic = m_message.flags & EVMC_STATIC;
+
+	switch (instruction)
+	{
+	case Instruction::STOP:
+		return EVMC_SUCCESS;
+	// --------------- arithmetic ---------------
+	case Instruction::ADD:
+	{
+		u256 a = pop();
+		m_stack.back() += a;
+		break;
+	}
+	case Instruction::MUL:
+	{
+		u256 a = pop();
+		m_stack.back() *= a;
+		break;
+	}
+	case Instruction::SUB:
+	{
+		u256 a = pop();
+		m_stack.back() = a - m_stack.back();
+		break;
+	}
+	case Instruction::DIV:
+	{
+		u256 a = pop();
+		u256& b = m_stack.back();
+		b = b == 0 ? 0 : a / b;
+		break;
+	}
+	case Instruction::SDIV:
+	{
+		u256 a = pop();
+		u256& b = m_stack.back();
+		b = b == 0 ? 0 : s2u(u2s(a) / u2s(b));
+		break;
+	}
+	case Instruction::MOD:
+	{
+		u256 a = pop();
+		u256& b = m_stack.back();
+		b = b == 0 ? 0 : a % b;
+		break;
+	}
+	case Instruction::SMOD:
+	{
+		u256 a = pop();
+		u256& b = m_stack.back();
+		b = b == 0 ? 0 : s2u(u2s(a) % u2s(b));
+		break;
+	}
+	case Instruction::ADDMOD:
+	{
+		u256 a = pop();
+		u256 b = pop();
+		u256& m = m_stack.back();
+		m = m == 0 ? 0 : u256((u512(a) + u512(b)) % m);
+		break;
+	}
+	case Instruction::MULMOD:
+	{
+		u256 a = pop();
+		u256 b = pop();
+		u256& m = m_stack.back();
+		m = m == 0 ? 0 : u256((u512(a) * u512(b)) % m);
+		break;
+	}
+	case Instruction::EXP:
+	{
+		u256 base = pop();
+		u256& exponent = m_stack.back();
+		unsigned exponentBytes = exponent == 0 ? 0 : (unsigned(boost::multiprecision::msb(exponent)) / 8 + 1);
+		if (!consumeGas(int64_t(exponentBytes * GasCosts::expByteGas(m_evmVersion))))
+			return EVMC_OUT_OF_GAS;
+		exponent = exp256(base, exponent);
+		break;
+	}
+	case Instruction::SIGNEXTEND:
+	{
+		u256 position = pop();
+		u256& value = m_stack.back();
+		if (position < 31)
+		{
+			unsigned testBit = unsigned(position) * 8 + 7;
+			u256 mask = (u256(1) << testBit) - 1;
+			if (boost::multiprecision::bit_test(value, testBit))
+				value |= ~mask;
+			else
+				value &= mask;
+		}
+		break;
+	}
+	// --------------- comparison and bitwise ---------------
+	case Instruction::LT:
+	{
+		u256 a = pop();
+		m_stack.back() = a < m_stack.back() ? 1 : 0;
+		break;
+	}
+	case Instruction::GT:
+	{
+		u256 a = pop();
+		m_stack.back() = a > m_stack.back() ? 1 : 0;
+		break;
+	}
+	case Instruction::SLT:
+	{
+		u256 a = pop();
+		m_stack.back() = u2s(a) < u2s(m_stack.back()) ? 1 : 0;
+		break;
+	}
+	case Instruction::SGT:
+	{
+		u256 a = pop();
+		m_stack.back() = u2s(a) > u2s(m_stack.back()) ? 1 : 0;
+		break;
+	}
+	case Instruction::EQ:
+	{
+		u256 a = pop();
+		m_stack.back() = a == m_stack.back() ? 1 : 0;
+		break;
+	}
+	case Instruction::ISZERO:
+		m_stack.back() = m_stack.back() == 0 ? 1 : 0;
+		break;
+	case Instruction::AND:
+	{
+		u256 a = pop();
+		m_stack.back() &= a;
+		break;
+	}
+	case Instruction::OR:
+	{
+		u256 a = pop();
+		m_stack.back() |= a;
+		break;
+	}
+	case Instruction::XOR:
+	{
+		u256 a = pop();
+		m_stack.back() ^= a;
+		break;
+	}
+	case Instruction::NOT:
+		m_stack.back() = ~m_stack.back();
+		break;
+	case Instruction::BYTE:
+	{
+		u256 position = pop();
+		u256& value = m_stack.back();
+		value = position >= 32 ? 0 : (value >> unsigned(8 * (31 - position))) & 0xff;
+		break;
+	}
+	case Instruction::SHL:
+	{
+		u256 shift = pop();
+		u256& value = m_stack.back();
+		value = shift > 255 ? 0 : (value << unsigned(shift));
+		break;
+	}
+	case Instruction::SHR:
+	{
+		u256 shift = pop();
+		u256& value = m_stack.back();
+		value = shift > 255 ? 0 : (value >> unsigned(shift));
+		break;
+	}
+	case Instruction::SAR:
+	{
+		static u256 const hibit = u256(1) << 255;
+		u256 shift = pop();
+		u256& value = m_stack.back();
+		bool negative = (value & hibit) != 0;
+		if (shift >= 256)
+			value = negative ? ~u256(0) : 0;
+		else
+		{
+			unsigned amount = unsigned(shift);
+			value >>= amount;
+			if (negative && amount > 0)
+				value |= ~u256(0) << (256 - amount);
+		}
+		break;
+	}
+	case Instruction::KECCAK256:
+	{
+		u256 offset = pop();
+		u256& size = m_stack.back();
+		if (!expandMemory(offset, size) || !consumeWordGas(size, GasCosts::keccak256WordGas))
+			return EVMC_OUT_OF_GAS;
+		size = u256(keccak256(bytesConstRef(memoryPointer(offset, size), size_t(size))));
+		break;
+	}
+	// --------------- environment ---------------
+	case Instruction::ADDRESS:
+		push(fromEVMC(m_message.destination));
+		break;
+	case Instruction::BALANCE:
+		m_stack.back() = fromEVMC(m_host.get_balance(toAddress(m_stack.back())));
+		break;
+	case Instruction::SELFBALANCE:
+		push(fromEVMC(m_host.get_balance(m_message.destination)));
+		break;
+	case Instruction::ORIGIN:
+		push(fromEVMC(m_host.get_tx_context().tx_origin));
+		break;
+	case Instruction::CALLER:
+		push(fromEVMC(m_message.sender));
+		break;
+	case Instruction::CALLVALUE:
+		push(fromEVMC(m_message.value));
+		break;
+	case Instruction::CALLDATALOAD:
+	{
+		u256& offset = m_stack.back();
+		u256 value;
+		for (size_t i = 0; i < 32; ++i)
+			value = (value << 8) | (offset + i < m_message.input_size ? m_message.input_data[size_t(offset) + i] : 0);
+		offset = value;
+		break;
+	}
+	case Instruction::CALLDATASIZE:
+		push(m_message.input_size);
+		break;
+	case Instruction::CODESIZE:
+		push(m_codeSize);
+		break;
+	case Instruction::CALLDATACOPY:
+	case Instruction::CODECOPY:
+	case Instruction::RETURNDATACOPY:
+	{
+		u256 memoryOffset = pop();
+		u256 sourceOffset = pop();
+		u256 size = pop();
+		if (!expandMemory(memoryOffset, size) || !consumeWordGas(size, GasCosts::copyGas))
+			return EVMC_OUT_OF_GAS;
+		if (instruction == Instruction::CALLDATACOPY)
+			copyToMemory(memoryOffset, m_message.input_data, m_message.input_size, sourceOffset, size);
+		else if (instruction == Instruction::CODECOPY)
+			copyToMemory(memoryOffset, m_code, m_codeSize, sourceOffset, size);
+		else
+		{
+			// Written such that sourceOffset + size cannot overflow.
+			if (size > m_returnData.size() || sourceOffset > m_returnData.size() - size)
+				return EVMC_INVALID_MEMORY_ACCESS;
+			copyToMemory(memoryOffset, m_returnData.data(), m_returnData.size(), sourceOffset, size);
+		}
+		break;
+	}
+	case Instruction::GASPRICE:
+		push(fromEVMC(m_host.get_tx_context().tx_gas_price));
+		break;
+	case Instruction::EXTCODESIZE:
+		m_stack.back() = m_host.get_code_size(toAddress(m_stack.back()));
+		break;
+	case Instruction::EXTCODEHASH:
+		m_stack.back() = fromEVMC(m_host.get_code_hash(toAddress(m_stack.back())));
+		break;
+	case Instruction::EXTCODECOPY:
+	{
+		evmc::address address = toAddress(pop());
+		u256 memoryOffset = pop();
+		u256 codeOffset = pop();
+		u256 size = pop();
+		if (!expandMemory(memoryOffset, size) || !consumeWordGas(size, GasCosts::copyGas))
+			return EVMC_OUT_OF_GAS;
+		if (size > 0)
+		{
+			size_t copied = 0;
+			if (codeOffset < c_maxBufferSize)
+				copied = m_host.copy_code(address, size_t(codeOffset), m_memory.data() + size_t(memoryOffset), size_t(size));
+			memset(m_memory.data() + size_t(memoryOffset) + copied, 0, size_t(size) - copied);
+		}
+		break;
+	}
+	case Instruction::RETURNDATASIZE:
+		push(m_returnData.size());
+		break;
+	// --------------- block information ---------------
+	case Instruction::BLOCKHASH:
+	{
+		u256& number = m_stack.back();
+		u256 current = u256(m_host.get_tx_context().block_number);
+		if (number < current && number + 256 >= current)
+			number = fromEVMC(m_host.get_block_hash(int64_t(number)));
+		else
+			number = 0;
+		break;
+	}
+	case Instruction::COINBASE:
+		push(fromEVMC(m_host.get_tx_context().block_coinbase));
+		break;
+	case Instruction::TIMESTAMP:
+		push(u256(m_host.get_tx_context().block_timestamp));
+		break;
+	case Instruction::NUMBER:
+		push(u256(m_host.get_tx_context().block_number));
+		break;
+	case Instruction::DIFFICULTY:
+		push(fromEVMC(m_host.get_tx_context().block_difficulty));
+		break;
+	case Instruction::GASLIMIT:
+		push(u256(m_host.get_tx_context().block_gas_limit));
+		break;
+	case Instruction::CHAINID:
+		push(fromEVMC(m_host.get_tx_context().chain_id));
+		break;
+	// --------------- stack, memory, storage and flow ---------------
+	case Instruction::POP:
+		m_stack.pop_back();
+		break;
+	case Instruction::MLOAD:
+	{
+		u256& offset = m_stack.back();
+		if (!expandMemory(offset, 32))
+			return EVMC_OUT_OF_GAS;
+		u256 value;
+		for (size_t i = 0; i < 32; ++i)
+			value = (value << 8) | m_memory[size_t(offset) + i];
+		offset = value;
+		break;
+	}
+	case Instruction::MSTORE:
+	{
+		u256 offset = pop();
+		u256 value = pop();
+		if (!expandMemory(offset, 32))
+			return EVMC_OUT_OF_GAS;
+		evmc::bytes32 word = toBytes32(value);
+		memcpy(m_memory.data() + size_t(offset), word.bytes, 32);
+		break;
+	}
+	case Instruction::MSTORE8:
+	{
+		u256 offset = pop();
+		u256 value = pop();
+		if (!expandMemory(offset, 1))
+			return EVMC_OUT_OF_GAS;
+		m_memory[size_t(offset)] = uint8_t(value & 0xff);
+		break;
+	}
+	case Instruction::SLOAD:
+		m_stack.back() = fromEVMC(m_host.get_storage(m_message.destination, toBytes32(m_stack.back())));
+		break;
+	case Instruction::SSTORE:
+		if (isStatic)
+			return EVMC_STATIC_MODE_VIOLATION;
+		if (auto status = executeStorageStore(); status != EVMC_SUCCESS)
+			return status;
+		break;
+	case Instruction::JUMP:
+	{
+		u256 destination = pop();
+		if (!isValidJumpDestination(destination))
+			return EVMC_BAD_JUMP_DESTINATION;
+		m_pc = size_t(destination);
+		return nullopt;
+	}
+	case Instruction::JUMPI:
+	{
+		u256 destination = pop();
+		u256 condition = pop();
+		if (condition == 0)
+			break;
+		if (!isValidJumpDestination(destination))
+			return EVMC_BAD_JUMP_DESTINATION;
+		m_pc = size_t(destination);
+		return nullopt;
+	}
+	case Instruction::PC:
+		push(m_pc);
+		break;
+	case Instruction::MSIZE:
+		push(m_memory.size());
+		break;
+	case Instruction::GAS:
+		push(m_gas);
+		break;
+	case Instruction::JUMPDEST:
+		break;
+	// --------------- logging ---------------
+	case Instruction::LOG0:
+	case Instruction::LOG1:
+	case Instruction::LOG2:
+	case Instruction::LOG3:
+	case Instruction::LOG4:
+	{
+		if (isStatic)
+			return EVMC_STATIC_MODE_VIOLATION;
+		u256 offset = pop();
+		u256 size = pop();
+		size_t const numTopics = size_t(opcode - uint8_t(Instruction::LOG0));
+		array<evmc::bytes32, 4> topics;
+		for (size_t i = 0; i < numTopics; ++i)
+			topics[i] = toBytes32(pop());
+		if (!expandMemory(offset, size))
+			return EVMC_OUT_OF_GAS;
+		if (!consumeGas(int64_t(size) * GasCosts::logDataGas))
+			return EVMC_OUT_OF_GAS;
+		m_host.emit_log(m_message.destination, memoryPointer(offset, size), size_t(size), topics.data(), numTopics);
+		break;
+	}
+	// --------------- calls and termination ---------------
+	case Instruction::CREATE:
+	case Instruction::CREATE2:
+		if (isStatic)
+			return EVMC_STATIC_MODE_VIOLATION;
+		if (auto status = executeCreate(instruction); status != EVMC_SUCCESS)
+			return status;
+		break;
+	case Instruction::CALL:
+	case Instruction::CALLCODE:
+	case Instruction::DELEGATECALL:
+	case Instruction::STATICCALL:
+		if (auto status = executeCall(instruction); status != EVMC_SUCCESS)
+			return status;
+		break;
+	case Instruction::RETURN:
+	case Instruction::REVERT:
+	{
+		u256 offset = pop();
+		u256 size = pop();
+		if (!expandMemory(offset, size))
+			return EVMC_OUT_OF_GAS;
+		if (size > 0)
+			m_output.assign(m_memory.begin() + ptrdiff_t(offset), m_memory.begin() + ptrdiff_t(offset + size));
+		return instruction == Instruction::RETURN ? EVMC_SUCCESS : EVMC_REVERT;
+	}
+	case Instruction::INVALID:
+		return EVMC_INVALID_INSTRUCTION;
+	case Instruction::SELFDESTRUCT:
+		if (isStatic)
+			return EVMC_STATIC_MODE_VIOLATION;
+		return executeSelfdestruct();
+	default:
+		return EVMC_UNDEFINED_INSTRUCTION;
+	}
+
+	++m_pc;
+	return nullopt;
+}
+
+evmc_status_code Execution::executeStorageStore()
+{
+	if (m_evmVersion >= langutil::EVMVersion::istanbul() && m_gas <= int64_t(GasCosts::callStipend))
+		return EVMC_OUT_OF_GAS;
+
+	evmc::bytes32 key = toBytes32(pop());
+	evmc::bytes32 value = toBytes32(pop());
+
+	int64_t cost = 0;
+	bool const netGasMetering =
+		m_evmVersion == langutil::EVMVersion::constantinople() ||
+		m_evmVersion >= langutil::EVMVersion::istanbul();
+	if (netGasMetering)
+		switch (m_host.set_storage(m_message.destination, key, value))
+		{
+		case EVMC_STORAGE_UNCHANGED:
+		case EVMC_STORAGE_MODIFIED_AGAIN:
+			cost = m_evmVersion >= langutil::EVMVersion::istanbul() ? GasCosts::sloadGas(m_evmVersion) : 200;
+			break;
+		case EVMC_STORAGE_ADDED:
+			cost = GasCosts::sstoreSetGas;
+			break;
+		case EVMC_STORAGE_MODIFIED:
+		case EVMC_STORAGE_DELETED:
+			cost = GasCosts::sstoreResetGas;
+			break;
+		}
+	else
+	{
+		bool isSet = !m_host.get_storage(m_message.destination, key) && value;
+		cost = isSet ? GasCosts::sstoreSetGas : GasCosts::sstoreResetGas;
+		m_host.set_storage(m_message.destination, key, value);
+	}
+	return consumeGas(cost) ? EVMC_SUCCESS : EVMC_OUT_OF_GAS;
+}
+
+evmc_status_code Execution::executeSelfdestruct()
+{
+	evmc::address beneficiary = toAddress(pop());
+	if (m_evmVersion >= langutil::EVMVersion::tangerineWhistle())
+	{
+		bool chargeNewAccount = !m_host.account_exists(beneficiary);
+		if (m_evmVersion >= langutil::EVMVersion::spuriousDragon())
+			chargeNewAccount = chargeNewAccount && fromEVMC(m_host.get_balance(m_message.destination)) != 0;
+		if (chargeNewAccount && !consumeGas(GasCosts::callNewAccountGas))
+			return EVMC_OUT_OF_GAS;
+	}
+	m_host.selfdestruct(m_message.destination, beneficiary);
+	return EVMC_SUCCESS;
+}
+
+evmc_status_code Execution::executeCreate(Instruction _instruction)
+{
+	u256 value = pop();
+	u256 offset = pop();
+	u256 size = pop();
+	u256 salt = _instruction == Instruction::CREATE2 ? pop() : 0;
+
+	if (!expandMemory(offset, size))
+		return EVMC_OUT_OF_GAS;
+	if (_instruction == Instruction::CREATE2 && !consumeWordGas(size, GasCosts::keccak256WordGas))
+		return EVMC_OUT_OF_GAS;
+
+	m_returnData.clear();
+	push(0);
+
+	if (m_message.depth >= c_callDepthLimit)
+		return EVMC_SUCCESS;
+	if (value > 0 && fromEVMC(m_host.get_balance(m_message.destination)) < value)
+		return EVMC_SUCCESS;
+
+	evmc_message message{};
+	message.kind = _instruction == Instruction::CREATE ? EVMC_CREATE : EVMC_CREATE2;
+	message.depth = m_message.depth + 1;
+	message.gas = m_gas;
+	if (m_evmVersion >= langutil::EVMVersion::tangerineWhistle())
+		message.gas -= message.gas / 64;
+	message.sender = m_message.destination;
+	message.input_data = memoryPointer(offset, size);
+	message.input_size = size_t(size);
+	message.value = toBytes32(value);
+	message.create2_salt = toBytes32(salt);
+
+	m_gas -= message.gas;
+	evmc::result result = m_host.call(message);
+	m_gas += result.gas_left;
+
+	if (result.status_code == EVMC_SUCCESS)
+		m_stack.back() = fromEVMC(result.create_address);
+	else
+		m_returnData.assign(result.output_data, result.output_data + result.output_size);
+	return EVMC_SUCCESS;
+}
+
+evmc_status_code Execution::executeCall(Instruction _instruction)
+{
+	bool const hasValueArgument = _instruction == Instruction::CALL || _instruction == Instruction::CALLCODE;
+
+	u256 gas = pop();
+	evmc::address destination = toAddress(pop());
+	u256 value = hasValueArgument ? pop() : 0;
+	u256 inputOffset = pop();
+	u256 inputSize = pop();
+	u256 outputOffset = pop();
+	u256 outputSize = pop();
+
+	if (!expandMemory(inputOffset, inputSize) || !expandMemory(outputOffset, outputSize))
+		return EVMC_OUT_OF_GAS;
+
+	bool const hasValue = value != 0;
+	if (hasValue)
+	{
+		if (_instruction == Instruction::CALL && (m_message.flags & EVMC_STATIC))
+			return EVMC_STATIC_MODE_VIOLATION;
+		if (!consumeGas(GasCosts::callValueTransferGas))
+			return EVMC_OUT_OF_GAS;
+	}
+	if (_instruction == Instruction::CALL)
+	{
+		bool chargeNewAccount = hasValue || m_evmVersion < langutil::EVMVersion::spuriousDragon();
+		if (chargeNewAccount && !m_host.account_exists(destination) && !consumeGas(GasCosts::callNewAccountGas))
+			return EVMC_OUT_OF_GAS;
+	}
+
+	int64_t callGas = toGas(gas);
+	if (m_evmVersion >= langutil::EVMVersion::tangerineWhistle())
+		callGas = min(callGas, m_gas - m_gas / 64);
+	else if (callGas > m_gas)
+		return EVMC_OUT_OF_GAS;
+	m_gas -= callGas;
+	if (hasValue)
+		callGas += GasCosts::callStipend;
+
+	m_returnData.clear();
+	push(0);
+
+	if (
+		m_message.depth >= c_callDepthLimit ||
+		(hasValue && fromEVMC(m_host.get_balance(m_message.destination)) < value)
+	)
+	{
+		m_gas += callGas;
+		return EVMC_SUCCESS;
+	}
+
+	evmc_message message{};
+	message.kind =
+		_instruction == Instruction::DELEGATECALL ? EVMC_DELEGATECALL :
+		_instruction == Instruction::CALLCODE ? EVMC_CALLCODE :
+		EVMC_CALL;
+	message.flags = _instruction == Instruction::STATICCALL ? uint32_t(EVMC_STATIC) : m_message.flags;
+	message.depth = m_message.depth + 1;
+	message.gas = callGas;
+	message.destination = destination;
+	if (_instruction == Instruction::DELEGATECALL)
+	{
+		message.sender = m_message.sender;
+		message.value = m_message.value;
+	}
+	else
+	{
+		message.sender = m_message.destination;
+		message.value = toBytes32(value);
+	}
+	message.input_data = memoryPointer(inputOffset, inputSize);
+	message.input_size = size_t(inputSize);
+
+	evmc::result result = m_host.call(message);
+	m_gas += result.gas_left;
+
+	m_returnData.assign(result.output_data, result.output_data + result.output_size);
+	if (size_t copySize = min(size_t(outputSize), result.output_size))
+		memcpy(m_memory.data() + size_t(outputOffset), result.output_data, copySize);
+	m_stack.back() = result.status_code == EVMC_SUCCESS ? 1 : 0;
+	return EVMC_SUCCESS;
+}
+
+evmc_result execute(
+	evmc_vm* _vm,
+	evmc_host_interface const* _host,
+	evmc_host_context* _context,
+	evmc_revision _revision,
+	evmc_message const* _message,
+	uint8_t const* _code,
+	size_t _codeSize
+)
+{
+	try
+	{
+		evmc::HostContext host{*_host, _context};
+		return Execution(
+			host,
+			_revision,
+			*_message,
+			_code,
+			_codeSize,
+			static_cast<InterpreterVM*>(_vm)->tracer
+		).run().release_raw();
+	}
+	catch (...)
+	{
+		return evmc::make_result(EVMC_INTERNAL_ERROR, 0, nullptr, 0);
+	}
+}
+
+}
+
+evmc_vm* EVMInterpreter::create(EVMTracer* _tracer)
+{
+	return new InterpreterVM{
+		{
+			EVMC_ABI_VERSION,
+			"soltest-evm",
+			"0.1.0",
+			[](evmc_vm* _vm) { delete static_cast<InterpreterVM*>(_vm); },
+			execute,
+			[](evmc_vm*) -> evmc_capabilities_flagset { return EVMC_CAPABILITY_EVM1; },
+			nullptr
+		},
+		_tracer
+	};
+}
+
+langutil::EVMVersion EVMInterpreter::evmVersion(evmc_revision _revision)
+{
+	switch (_revision)
+	{
+	case EVMC_FRONTIER:
+	case EVMC_HOMESTEAD:
+		return langutil::EVMVersion::homestead();
+	case EVMC_TANGERINE_WHISTLE:
+		return langutil::EVMVersion::tangerineWhistle();
+	case EVMC_SPURIOUS_DRAGON:
+		return langutil::EVMVersion::spuriousDragon();
+	case EVMC_BYZANTIUM:
+		return langutil::EVMVersion::byzantium();
+	case EVMC_CONSTANTINOPLE:
+		return langutil::EVMVersion::constantinople();
+	case EVMC_PETERSBURG:
+		return langutil::EVMVersion::petersburg();
+	case EVMC_ISTANBUL:
+		return langutil::EVMVersion::istanbul();
+	case EVMC_BERLIN:
+		return langutil::EVMVersion::berlin();
+	}
+	return langutil::EVMVersion::istanbul();
+}
@@ -0,0 +1,80 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * EVM bytecode interpreter implementing the EVMC VM interface.
+ */
+
+#pragma once
+
+#include <test/evmc/evmc.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <libsolutil/CommonData.h>
+
+namespace solidity::test
+{
+
+/**
+ * Observer of the execution performed by EVMInterpreter.
+ *
+ * Call frames are reported in a nested way: all frames created by an instruction
+ * are entered and left between the start and the end of that instruction.
+ */
+class EVMTracer
+{
+public:
+	virtual ~EVMTracer() = default;
+
+	/// Called before the first instruction of a new call frame executing @a _code is run.
+	virtual void enterFrame(evmc_message const& _message, bytesConstRef _code) = 0;
+	/// Called before the instruction at @a _pc of the current frame is executed.
+	virtual void startInstruction(size_t _pc) = 0;
+	/// Called after the instruction that was started last in the current frame finished.
+	/// @a _gasUsed includes the gas used by the call frames created by the instruction.
+	/// If the instruction aborts the frame, all the gas left in the frame is counted.
+	virtual void endInstruction(int64_t _gasUsed) = 0;
+	/// Called after the last instruction of the current call frame.
+	virtual void leaveFrame() = 0;
+};
+
+/**
+ * Self-contained EVM bytecode interpreter that can be used by EVMHost instead of
+ * a dynamically loaded evmone library.
+ *
+ * It executes a single call frame per invocation of `execute` and relies on the host
+ * for everything that concerns other accounts (calls, creation, balances, storage),
+ * exactly like any other EVMC VM.
+ *
+ * Gas is charged per instruction according to the schedule of the EVM revision
+ * requested by the host. Refunds are not tracked (EVMC does not report them) and
+ * the intrinsic transaction costs are left to the host.
+ */
+class EVMInterpreter
+{
+public:
+	/// @returns a newly created EVMC VM instance of the interpreter. The instance has to be
+	/// destroyed through its `destroy` member, which evmc::VM does automatically.
+	/// If @a _tracer is given, it is notified about every executed instruction. It has
+	/// to outlive the instance.
+	static evmc_vm* create(EVMTracer* _tracer = nullptr);
+
+	/// @returns the EVM version whose rules apply to the given EVMC revision.
+	static langutil::EVMVersion evmVersion(evmc_revision _revision);
+};
+
+}
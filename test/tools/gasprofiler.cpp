@@ -0,0 +1,654 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Source level gas profiler: executes a compiled contract and attributes the gas used by
+ * each instruction to Solidity functions and source lines via the source mappings.
+ */
+
+#include <test/EVMHost.h>
+#include <test/tools/evmInterpreter/EVMInterpreter.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <liblangutil/EVMVersion.h>
+#include <liblangutil/Scanner.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libevmasm/Instruction.h>
+#include <libevmasm/LinkerObject.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+using namespace solidity::test;
+using namespace evmc::literals;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Single entry of a (decompressed) source mapping.
+struct SourceMapEntry
+{
+	int start = -1;
+	int length = -1;
+	int sourceIndex = -1;
+	char jumpType = '-';
+};
+
+/// Decompresses a source mapping as produced by `evmasm::AssemblyItem::computeSourceMapping`.
+vector<SourceMapEntry> parseSourceMap(string const& _sourceMap)
+{
+	vector<SourceMapEntry> entries;
+	SourceMapEntry current;
+	vector<string> items;
+	boost::split(items, _sourceMap, boost::is_any_of(";"));
+	for (string const& item: items)
+	{
+		vector<string> fields;
+		boost::split(fields, item, boost::is_any_of(":"));
+		if (fields.size() > 0 && !fields[0].empty())
+			current.start = stoi(fields[0]);
+		if (fields.size() > 1 && !fields[1].empty())
+			current.length = stoi(fields[1]);
+		if (fields.size() > 2 && !fields[2].empty())
+			current.sourceIndex = stoi(fields[2]);
+		if (fields.size() > 3 && !fields[3].empty())
+			current.jumpType = fields[3][0];
+		entries.push_back(current);
+	}
+	return entries;
+}
+
+/**
+ * Collects the source ranges of all functions and modifiers, so that source locations
+ * can be mapped to the innermost callable containing them.
+ */
+class CallableCollector: private ASTConstVisitor
+{
+public:
+	struct Callable
+	{
+		int start;
+		int end;
+		string name;
+	};
+
+	explicit CallableCollector(SourceUnit const& _sourceUnit) { _sourceUnit.accept(*this); }
+
+	/// @returns the name of the innermost callable (or contract) containing [_start, _end)
+	/// or an empty string if there is none.
+	string const& find(int _start, int _end) const
+	{
+		static string const empty;
+		Callable const* innermost = nullptr;
+		for (Callable const& callable: m_callables)
+			if (callable.start <= _start && _end <= callable.end)
+				if (!innermost || callable.end - callable.start < innermost->end - innermost->start)
+					innermost = &callable;
+		return innermost ? innermost->name : empty;
+	}
+
+private:
+	bool visit(ContractDefinition const& _contract) override
+	{
+		m_contractName = _contract.name();
+		add(_contract, m_contractName);
+		return true;
+	}
+	bool visit(FunctionDefinition const& _function) override
+	{
+		string name = _function.name();
+		if (_function.isConstructor())
+			name = "constructor";
+		else if (_function.isFallback())
+			name = "fallback";
+		else if (_function.isReceive())
+			name = "receive";
+		add(_function, m_contractName + "." + name);
+		return false;
+	}
+	bool visit(ModifierDefinition const& _modifier) override
+	{
+		add(_modifier, m_contractName + "." + _modifier.name());
+		return false;
+	}
+
+	void add(ASTNode const& _node, string _name)
+	{
+		m_callables.push_back({_node.location().start, _node.location().end, move(_name)});
+	}
+
+	string m_contractName;
+	vector<Callable> m_callables;
+};
+
+/**
+ * Tracer that attributes the gas used by every executed instruction to a stack of
+ * callables and a source line.
+ *
+ * Internal function calls are tracked through the jump types of the source mapping,
+ * external calls through the nesting of call frames.
+ */
+class GasProfiler: public EVMTracer
+{
+public:
+	GasProfiler(CompilerStack const& _compiler, vector<string> const& _contracts);
+
+	void enterFrame(evmc_message const& _message, bytesConstRef _code) override;
+	void startInstruction(size_t _pc) override;
+	void endInstruction(int64_t _gasUsed) override;
+	void leaveFrame() override;
+
+	/// Discards everything recorded so far.
+	void clear();
+	/// @returns the gas used by all instructions of the outermost call frames.
+	int64_t tracedGas() const { return m_tracedGas; }
+
+	/// Prints stacks in the "folded" format understood by flamegraph.pl and similar tools.
+	/// @a _overhead is reported as a separate stack.
+	void printFolded(ostream& _out, int64_t _overhead) const;
+	/// Prints the gas per callable and per source line, the most expensive first.
+	void printSummary(ostream& _out, int64_t _overhead) const;
+
+private:
+	/// Position of an instruction in a compiled contract.
+	struct Position
+	{
+		size_t callable;
+		/// Label of the source line, if the instruction has a source location.
+		optional<size_t> line;
+		char jumpType;
+	};
+
+	/// Information about a known piece of bytecode, indexed by program counter.
+	struct Code
+	{
+		vector<optional<Position>> positions;
+	};
+
+	struct Frame
+	{
+		Code const* code;
+		size_t pc = 0;
+		/// Labels of the callables that made the internal function calls still active.
+		vector<size_t> callers;
+		/// Gas used by frames created by the current instruction.
+		int64_t nestedGas = 0;
+		/// Gas used by all instructions of this frame.
+		int64_t totalGas = 0;
+	};
+
+	void addCode(evmasm::LinkerObject const& _object, string const& _sourceMap, string const& _contractName, bool _runtime);
+	/// @returns the code whose positions apply to @a _code or nullptr if it is unknown.
+	Code const* findCode(bytesConstRef _code) const;
+	size_t label(string const& _name);
+	/// @returns the label of the callable executing at the current instruction of @a _frame.
+	size_t currentCallable(Frame const& _frame) const;
+
+	CompilerStack const& m_compiler;
+	map<string, CallableCollector> m_callables;
+	vector<string> m_labels;
+	map<string, size_t> m_labelIndices;
+	map<size_t, string> m_lineTexts;
+	/// Known code, by hash of the runtime bytecode.
+	map<h256, Code> m_runtimeCode;
+	/// Sorted offsets of the immutables in each known runtime code that contains any.
+	vector<vector<size_t>> m_immutableOffsets;
+	/// Known code, by creation bytecode (without constructor arguments).
+	vector<pair<bytes, Code>> m_creationCode;
+	size_t m_unknownCode;
+
+	vector<Frame> m_frames;
+	int64_t m_tracedGas = 0;
+	map<vector<size_t>, int64_t> m_stacks;
+	map<size_t, int64_t> m_callableGas;
+	map<size_t, int64_t> m_lineGas;
+};
+
+GasProfiler::GasProfiler(CompilerStack const& _compiler, vector<string> const& _contracts):
+	m_compiler(_compiler)
+{
+	for (string const& sourceName: m_compiler.sourceNames())
+		m_callables.emplace(sourceName, CallableCollector(m_compiler.ast(sourceName)));
+	m_unknownCode = label("<unknown code>");
+
+	for (string const& contract: _contracts)
+	{
+		string const shortName = contract.substr(contract.rfind(':') + 1);
+		if (string const* sourceMap = m_compiler.sourceMapping(contract))
+			addCode(m_compiler.object(contract), *sourceMap, shortName, false);
+		if (string const* sourceMap = m_compiler.runtimeSourceMapping(contract))
+			addCode(m_compiler.runtimeObject(contract), *sourceMap, shortName, true);
+	}
+}
+
+void GasProfiler::addCode(
+	evmasm::LinkerObject const& _object,
+	string const& _sourceMap,
+	string const& _contractName,
+	bool _runtime
+)
+{
+	bytes const& bytecode = _object.bytecode;
+	vector<string> sourceNames(m_compiler.sourceIndices().size());
+	for (auto const& [name, index]: m_compiler.sourceIndices())
+		sourceNames[index] = name;
+
+	vector<SourceMapEntry> entries = parseSourceMap(_sourceMap);
+	Code code;
+	code.positions.resize(bytecode.size());
+	size_t instruction = 0;
+	for (size_t pc = 0; pc < bytecode.size() && instruction < entries.size(); ++pc, ++instruction)
+	{
+		SourceMapEntry const& entry = entries[instruction];
+		Position position{label(_contractName), {}, entry.jumpType};
+		if (entry.sourceIndex >= 0 && size_t(entry.sourceIndex) < sourceNames.size())
+		{
+			string const& sourceName = sourceNames[size_t(entry.sourceIndex)];
+			string const& callable = m_callables.at(sourceName).find(entry.start, entry.start + entry.length);
+			if (!callable.empty())
+				position.callable = label(callable);
+
+			CharStream const& charStream = *m_compiler.scanner(sourceName).charStream();
+			int line = get<0>(charStream.translatePositionToLineColumn(entry.start));
+			position.line = label(sourceName + ":" + to_string(line + 1));
+			if (!m_lineTexts.count(*position.line))
+				m_lineTexts[*position.line] = boost::trim_copy(charStream.lineAtPosition(entry.start));
+		}
+		code.positions[pc] = position;
+		if (evmasm::isPushInstruction(evmasm::Instruction(bytecode[pc])))
+			pc += evmasm::getPushNumber(evmasm::Instruction(bytecode[pc]));
+	}
+
+	if (_runtime)
+	{
+		// The compiled code contains zeros in place of the values of immutables.
+		if (!_object.immutableReferences.empty())
+		{
+			vector<size_t> offsets;
+			for (auto const& [identifier, references]: _object.immutableReferences)
+				offsets += references;
+			sort(offsets.begin(), offsets.end());
+			if (find(m_immutableOffsets.begin(), m_immutableOffsets.end(), offsets) == m_immutableOffsets.end())
+				m_immutableOffsets.emplace_back(move(offsets));
+		}
+		m_runtimeCode[keccak256(bytecode)] = move(code);
+	}
+	else
+		m_creationCode.emplace_back(bytecode, move(code));
+}
+
+GasProfiler::Code const* GasProfiler::findCode(bytesConstRef _code) const
+{
+	auto runtimeCode = m_runtimeCode.find(keccak256(_code));
+	if (runtimeCode != m_runtimeCode.end())
+		return &runtimeCode->second;
+
+	// Deployed libraries contain their own address right at the start.
+	if (
+		_code.size() > 21 &&
+		_code[0] == uint8_t(evmasm::Instruction::PUSH20)
+	)
+	{
+		bytes withoutAddress = _code.toBytes();
+		fill(withoutAddress.begin() + 1, withoutAddress.begin() + 21, 0);
+		runtimeCode = m_runtimeCode.find(keccak256(withoutAddress));
+		if (runtimeCode != m_runtimeCode.end())
+			return &runtimeCode->second;
+	}
+
+	// The values of immutables are inserted into the code at deployment.
+	for (vector<size_t> const& offsets: m_immutableOffsets)
+	{
+		if (offsets.back() + 32 > _code.size())
+			continue;
+		bytes withoutImmutables = _code.toBytes();
+		for (size_t offset: offsets)
+			fill(withoutImmutables.begin() + ptrdiff_t(offset), withoutImmutables.begin() + ptrdiff_t(offset) + 32, 0);
+		runtimeCode = m_runtimeCode.find(keccak256(withoutImmutables));
+		if (runtimeCode != m_runtimeCode.end())
+			return &runtimeCode->second;
+	}
+
+	for (auto const& [bytecode, code]: m_creationCode)
+		if (bytecode.size() <= _code.size() && equal(bytecode.begin(), bytecode.end(), _code.begin()))
+			return &code;
+	return nullptr;
+}
+
+size_t GasProfiler::label(string const& _name)
+{
+	auto [it, inserted] = m_labelIndices.emplace(_name, m_labels.size());
+	if (inserted)
+		m_labels.push_back(_name);
+	return it->second;
+}
+
+size_t GasProfiler::currentCallable(Frame const& _frame) const
+{
+	if (!_frame.code || _frame.pc >= _frame.code->positions.size() || !_frame.code->positions[_frame.pc])
+		return m_unknownCode;
+	return _frame.code->positions[_frame.pc]->callable;
+}
+
+void GasProfiler::enterFrame(evmc_message const&, bytesConstRef _code)
+{
+	m_frames.push_back({findCode(_code), 0, {}, 0, 0});
+}
+
+void GasProfiler::startInstruction(size_t _pc)
+{
+	m_frames.back().pc = _pc;
+	m_frames.back().nestedGas = 0;
+}
+
+void GasProfiler::endInstruction(int64_t _gasUsed)
+{
+	Frame& frame = m_frames.back();
+	frame.totalGas += _gasUsed;
+	int64_t const gas = _gasUsed - frame.nestedGas;
+
+	// Jumps into a function carry the location of the function itself, so the same
+	// callable often appears twice in a row.
+	vector<size_t> stack;
+	auto pushCallable = [&](size_t _callable) {
+		if (stack.empty() || stack.back() != _callable)
+			stack.push_back(_callable);
+	};
+	for (Frame const& outerFrame: m_frames)
+	{
+		for (size_t caller: outerFrame.callers)
+			pushCallable(caller);
+		pushCallable(currentCallable(outerFrame));
+	}
+	optional<Position> position;
+	if (frame.code && frame.pc < frame.code->positions.size())
+		position = frame.code->positions[frame.pc];
+	if (position && position->line)
+	{
+		stack.push_back(*position->line);
+		m_lineGas[*position->line] += gas;
+	}
+	m_stacks[stack] += gas;
+	m_callableGas[currentCallable(frame)] += gas;
+
+	if (position && position->jumpType == 'i')
+		frame.callers.push_back(position->callable);
+	else if (position && position->jumpType == 'o' && !frame.callers.empty())
+		frame.callers.pop_back();
+}
+
+void GasProfiler::leaveFrame()
+{
+	int64_t const gas = m_frames.back().totalGas;
+	m_frames.pop_back();
+	if (m_frames.empty())
+		m_tracedGas += gas;
+	else
+		m_frames.back().nestedGas += gas;
+}
+
+void GasProfiler::clear()
+{
+	m_tracedGas = 0;
+	m_stacks.clear();
+	m_callableGas.clear();
+	m_lineGas.clear();
+}
+
+void GasProfiler::printFolded(ostream& _out, int64_t _overhead) const
+{
+	if (_overhead > 0)
+		_out << "<transaction> " << _overhead << endl;
+	for (auto const& [stack, gas]: m_stacks)
+	{
+		if (gas == 0)
+			continue;
+		for (size_t i = 0; i < stack.size(); ++i)
+			_out << (i == 0 ? "" : ";") << boost::replace_all_copy(m_labels[stack[i]], " ", "_");
+		_out << " " << gas << endl;
+	}
+}
+
+void GasProfiler::printSummary(ostream& _out, int64_t _overhead) const
+{
+	auto sortedByGas = [](map<size_t, int64_t> const& _gas)
+	{
+		vector<pair<size_t, int64_t>> sorted(_gas.begin(), _gas.end());
+		stable_sort(sorted.begin(), sorted.end(), [](auto const& _a, auto const& _b) { return _a.second > _b.second; });
+		return sorted;
+	};
+
+	_out << "Gas used: " << (m_tracedGas + _overhead) << endl;
+	_out << "  outside of executed code (intrinsic gas, code deposit): " << _overhead << endl;
+	_out << "  by executed code: " << m_tracedGas << endl;
+
+	_out << endl << "Gas by function (excluding called functions):" << endl;
+	for (auto const& [callable, gas]: sortedByGas(m_callableGas))
+		_out << setw(12) << gas << "  " << m_labels[callable] << endl;
+
+	_out << endl << "Gas by source line (excluding called functions):" << endl;
+	for (auto const& [line, gas]: sortedByGas(m_lineGas))
+		_out << setw(12) << gas << "  " << m_labels[line] << "  " << m_lineTexts.at(line) << endl;
+}
+
+void printErrors(CompilerStack const& _compiler)
+{
+	SourceReferenceFormatter formatter(cerr);
+	for (auto const& error: _compiler.errors())
+		formatter.printErrorInformation(*error);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(gasprofiler, source level gas profiler.
+Usage: gasprofiler [Options] <file>...
+Compiles the given Solidity files, deploys a contract and executes a call
+to it. The gas used by each instruction is attributed to the function and
+the source line it originates from. If no call data is given, the
+deployment is profiled instead.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("input-file", po::value<vector<string>>(), "input file")
+		("contract", po::value<string>(), "Name of the contract to deploy (default: the last one).")
+		("constructor-args", po::value<string>()->default_value(""), "Hex encoded constructor arguments.")
+		("calldata", po::value<string>(), "Hex encoded call data of the profiled call.")
+		("value", po::value<string>()->default_value("0"), "Value (in wei) sent with the profiled transaction.")
+		("gas", po::value<int64_t>()->default_value(20000000), "Gas limit of each transaction.")
+		("evm-version", po::value<string>(), "EVM version to compile and execute for.")
+		("optimize", "Enable the optimizer.")
+		("optimize-runs", po::value<unsigned>()->default_value(200), "Number of runs the optimizer tunes for.")
+		("folded", "Output the gas per stack in the folded format used by flame graph tools.")
+		("help", "Show this help screen.");
+
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-file"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	EVMVersion evmVersion;
+	if (arguments.count("evm-version"))
+	{
+		auto version = EVMVersion::fromString(arguments["evm-version"].as<string>());
+		if (!version)
+		{
+			cerr << "Invalid EVM version: " << arguments["evm-version"].as<string>() << endl;
+			return 1;
+		}
+		evmVersion = *version;
+	}
+
+	u256 value;
+	try
+	{
+		value = u256(arguments["value"].as<string>());
+	}
+	catch (runtime_error const&)
+	{
+		cerr << "Invalid value: " << arguments["value"].as<string>() << endl;
+		return 1;
+	}
+	bytes constructorArguments;
+	optional<bytes> callData;
+	try
+	{
+		constructorArguments = fromHex(arguments["constructor-args"].as<string>(), WhenError::Throw);
+		if (arguments.count("calldata"))
+			callData = fromHex(arguments["calldata"].as<string>(), WhenError::Throw);
+	}
+	catch (BadHexCharacter const&)
+	{
+		cerr << "Constructor arguments and call data have to be hex encoded." << endl;
+		return 1;
+	}
+
+	CompilerStack compiler([](string const& _kind, string const& _path) -> ReadCallback::Result {
+		if (_kind != ReadCallback::kindString(ReadCallback::Kind::ReadFile) || !boost::filesystem::exists(_path))
+			return {false, "File not found."};
+		return {true, readFileAsString(_path)};
+	});
+	StringMap sources;
+	for (string const& file: arguments["input-file"].as<vector<string>>())
+		sources[file] = readFileAsString(file);
+	compiler.setSources(sources);
+	compiler.setEVMVersion(evmVersion);
+	compiler.setOptimiserSettings(arguments.count("optimize") > 0, arguments["optimize-runs"].as<unsigned>());
+	if (!compiler.compile())
+	{
+		printErrors(compiler);
+		return 1;
+	}
+
+	vector<string> contracts = compiler.contractNames();
+	string contract = compiler.lastContractName();
+	if (arguments.count("contract"))
+	{
+		string const name = arguments["contract"].as<string>();
+		auto it = find_if(contracts.begin(), contracts.end(), [&](string const& _contract) {
+			return _contract == name || boost::ends_with(_contract, ":" + name);
+		});
+		if (it == contracts.end())
+		{
+			cerr << "Contract not found: " << name << endl;
+			return 1;
+		}
+		contract = *it;
+	}
+	if (!compiler.object(contract).linkReferences.empty())
+	{
+		cerr << "Contracts that need to be linked to libraries are not supported." << endl;
+		return 1;
+	}
+
+	GasProfiler profiler(compiler, contracts);
+	evmc::VM vm{EVMInterpreter::create(&profiler)};
+	EVMHost host(evmVersion, vm);
+	evmc::address const sender = 0x1212121212121212121212121212121212121212_address;
+	host.accounts[sender].balance = EVMHost::convertToEVMC(u256(1) << 100);
+
+	int64_t const gas = arguments["gas"].as<int64_t>();
+	auto execute = [&](evmc_call_kind _kind, evmc::address const& _destination, bytes const& _data, u256 const& _value)
+	{
+		host.newBlock();
+		evmc_message message = {};
+		message.kind = _kind;
+		message.sender = sender;
+		message.destination = _destination;
+		message.input_data = _data.data();
+		message.input_size = _data.size();
+		message.value = EVMHost::convertToEVMC(_value);
+		message.gas = gas;
+		evmc::result result = host.call(message);
+		if (result.status_code != EVMC_SUCCESS)
+			cerr << "Transaction failed with status " << result.status_code << "." << endl;
+		int64_t const gasUsed = gas - result.gas_left;
+		return pair<evmc::result, int64_t>{move(result), gasUsed};
+	};
+
+	auto [creationResult, creationGas] = execute(
+		EVMC_CREATE,
+		{},
+		compiler.object(contract).bytecode + constructorArguments,
+		callData ? 0 : value
+	);
+	int64_t gasUsed = creationGas;
+	if (callData)
+	{
+		if (creationResult.status_code != EVMC_SUCCESS)
+			return 1;
+		profiler.clear();
+		gasUsed = execute(
+			EVMC_CALL,
+			creationResult.create_address,
+			*callData,
+			value
+		).second;
+	}
+
+	int64_t const overhead = gasUsed - profiler.tracedGas();
+	if (arguments.count("folded"))
+		profiler.printFolded(cout, overhead);
+	else
+		profiler.printSummary(cout, overhead);
+
+	return 0;
+}
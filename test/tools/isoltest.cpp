@@ -422,13 +422,12 @@ int main(int argc, char const *argv[])
 
 	auto& options = dynamic_cast<solidity::test::IsolTestOptions const&>(solidity::test::CommonOptions::get());
 
-	bool disableSemantics = !solidity::test::EVMHost::getVM(options.evmonePath.string());
-	if (disableSemantics)
+	solidity::test::EVMHost::getVM(options.evmonePath.string());
+	if (solidity::test::EVMHost::isBuiltinVM())
 	{
-		cout << "Unable to find " << solidity::test::evmoneFilename << ". Please provide the path using --evmonepath <path>." << endl;
-		cout << "You can download it at" << endl;
-		cout << solidity::test::evmoneDownloadLink << endl;
-		cout << endl << "--- SKIPPING ALL SEMANTICS TESTS ---" << endl << endl;
+		cout << "Unable to find " << solidity::test::evmoneFilename << ". Using the built-in EVM interpreter instead." << endl;
+		cout << "To run the tests on evmone, provide its path using --evmonepath <path>. You can download it at" << endl;
+		cout << solidity::test::evmoneDownloadLink << endl << endl;
 	}
 
 	TestStats global_stats{0, 0};
@@ -438,9 +437,6 @@ int main(int argc, char const *argv[])
 	// Interactive tests are added in InteractiveTests.h
 	for (auto const& ts: g_interactiveTestsuites)
 	{
-		if (ts.needsVM && disableSemantics)
-			continue;
-
 		if (ts.smt && options.disableSMT)
 			continue;
 
@@ -469,8 +465,5 @@ int main(int argc, char const *argv[])
 	}
 	cout << "." << endl;
 
-	if (disableSemantics)
-		cout << "\nNOTE: Skipped semantics tests because " << solidity::test::evmoneFilename << " could not be found.\n" << endl;
-
 	return global_stats ? 0 : 1;
 }
@@ -18,33 +18,44 @@
  * Interactive yul optimizer
  */
 
+#include <test/EVMHost.h>
+#include <test/tools/evmInterpreter/EVMInterpreter.h>
+
 #include <libsolutil/CommonIO.h>
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/Scanner.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
+#include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/parsing/Parser.h>
 #include <libyul/AsmData.h>
 #include <libyul/AsmParser.h>
 #include <libyul/AsmPrinter.h>
+#include <libyul/AssemblyStack.h>
 #include <libyul/Object.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 
 #include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/Suite.h>
 
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+
+#include <libevmasm/LinkerObject.h>
 
 #include <libsolutil/JSON.h>
 
 #include <boost/program_options.hpp>
 
-#include <string>
-#include <sstream>
+#include <iomanip>
 #include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
 #include <variant>
 
 using namespace std;
@@ -53,6 +64,8 @@ using namespace solidity::util;
 using namespace solidity::langutil;
 using namespace solidity::frontend;
 using namespace solidity::yul;
+using namespace solidity::test;
+using namespace evmc::literals;
 
 namespace po = boost::program_options;
 
@@ -188,10 +201,147 @@ public:
 		}
 	}
 
+	/// Runs the default optimiser sequence and prints the code size and the gas used
+	/// when calling the code with each of @a _callData after every step.
+	void runMeasured(string const& _source, vector<bytes> const& _callData)
+	{
+		if (!parse(_source))
+			return;
+
+		Object object;
+		object.code = m_ast;
+		object.analysisInfo = m_analysisInfo;
+		GasMeter meter(m_dialect, false, 200);
+
+		vector<Measurement> measurements{measure("<initial>", *m_ast, _callData)};
+		printMeasurement(measurements.back(), nullptr);
+		OptimiserSuite::run(m_dialect, &meter, object, true, {}, [&](string const& _step, yul::Block const& _ast) {
+			measurements.push_back(measure(_step, _ast, _callData));
+			printMeasurement(measurements.back(), &measurements[measurements.size() - 2]);
+		});
+
+		// Sum up the changes by step.
+		map<string, Measurement> gains;
+		for (size_t i = 1; i < measurements.size(); ++i)
+		{
+			Measurement const& before = measurements[i - 1];
+			Measurement const& after = measurements[i];
+			Measurement& gain = gains.emplace(after.step, Measurement{after.step, 0, 0, 0}).first->second;
+			gain.codeSize += int64_t(before.codeSize) - int64_t(after.codeSize);
+			if (before.bytecodeSize && after.bytecodeSize)
+				*gain.bytecodeSize += *before.bytecodeSize - *after.bytecodeSize;
+			if (before.gas && after.gas)
+				*gain.gas += *before.gas - *after.gas;
+		}
+		vector<Measurement> sortedGains;
+		for (auto& [step, gain]: gains)
+			sortedGains.emplace_back(move(gain));
+		stable_sort(sortedGains.begin(), sortedGains.end(), [](Measurement const& _a, Measurement const& _b) {
+			return tie(*_a.gas, *_a.bytecodeSize, _a.codeSize) > tie(*_b.gas, *_b.bytecodeSize, _b.codeSize);
+		});
+
+		cout << endl << "Total reduction by step:" << endl;
+		printHeader();
+		for (Measurement const& gain: sortedGains)
+			printRow(gain);
+	}
+
 private:
+	/// Code size and gas after an optimiser step. Bytecode size and gas are missing
+	/// if the code could not be compiled, e.g. because of a stack that is too deep.
+	struct Measurement
+	{
+		string step;
+		int64_t codeSize;
+		optional<int64_t> bytecodeSize;
+		optional<int64_t> gas;
+	};
+
+	Measurement measure(string const& _step, yul::Block const& _ast, vector<bytes> const& _callData)
+	{
+		Measurement measurement{_step, int64_t(CodeSize::codeSizeIncludingFunctions(_ast)), {}, {}};
+
+		bytes bytecode;
+		try
+		{
+			AssemblyStack stack(m_evmVersion, AssemblyStack::Language::StrictAssembly, OptimiserSettings::none());
+			if (!stack.parseAndAnalyze("", AsmPrinter{}(_ast)))
+				return measurement;
+			bytecode = stack.assemble(AssemblyStack::Machine::EVM).bytecode->bytecode;
+		}
+		catch (Exception const&)
+		{
+			return measurement;
+		}
+		measurement.bytecodeSize = int64_t(bytecode.size());
+
+		int64_t constexpr gasLimit = 10000000;
+		evmc::address const sender = 0x1212121212121212121212121212121212121212_address;
+		evmc::address const destination = 0x3434343434343434343434343434343434343434_address;
+		measurement.gas = 0;
+		for (bytes const& callData: _callData)
+		{
+			// Every scenario starts from an empty state.
+			EVMHost host(m_evmVersion, m_vm);
+			host.accounts[destination].code = evmc::bytes(bytecode.begin(), bytecode.end());
+			evmc_message message = {};
+			message.kind = EVMC_CALL;
+			message.sender = sender;
+			message.destination = destination;
+			message.input_data = callData.data();
+			message.input_size = callData.size();
+			message.gas = gasLimit;
+			*measurement.gas += gasLimit - host.call(message).gas_left;
+		}
+		return measurement;
+	}
+
+	static void printHeader()
+	{
+		cout << setw(30) << left << "step";
+		cout << setw(12) << right << "code size" << setw(12) << "bytecode" << setw(12) << "gas" << endl;
+	}
+
+	static void printRow(Measurement const& _measurement)
+	{
+		cout << setw(30) << left << _measurement.step << right;
+		cout << setw(12) << _measurement.codeSize;
+		cout << setw(12) << (_measurement.bytecodeSize ? to_string(*_measurement.bytecodeSize) : "-");
+		cout << setw(12) << (_measurement.gas ? to_string(*_measurement.gas) : "-") << endl;
+	}
+
+	/// Prints the measurement after a step and how much it changed compared to @a _previous.
+	static void printMeasurement(Measurement const& _measurement, Measurement const* _previous)
+	{
+		if (!_previous)
+			printHeader();
+		printRow(_measurement);
+		if (!_previous)
+			return;
+		auto printChange = [](optional<int64_t> _before, optional<int64_t> _after) {
+			if (_before && _after && *_before != *_after)
+				cout << setw(12) << showpos << (*_after - *_before) << noshowpos;
+			else
+				cout << setw(12) << "";
+		};
+		if (
+			_previous->codeSize == _measurement.codeSize &&
+			_previous->bytecodeSize == _measurement.bytecodeSize &&
+			_previous->gas == _measurement.gas
+		)
+			return;
+		cout << setw(30) << "";
+		printChange(_previous->codeSize, _measurement.codeSize);
+		printChange(_previous->bytecodeSize, _measurement.bytecodeSize);
+		printChange(_previous->gas, _measurement.gas);
+		cout << endl;
+	}
+
 	ErrorList m_errors;
 	shared_ptr<yul::Block> m_ast;
-	Dialect const& m_dialect{EVMDialect::strictAssemblyForEVMObjects(EVMVersion{})};
+	EVMVersion m_evmVersion;
+	EVMDialect const& m_dialect{EVMDialect::strictAssemblyForEVMObjects(m_evmVersion)};
+	evmc::VM m_vm{EVMInterpreter::create()};
 	shared_ptr<AsmAnalysisInfo> m_analysisInfo;
 	shared_ptr<NameDispenser> m_nameDispenser;
 };
@@ -202,7 +352,8 @@ int main(int argc, char** argv)
 		R"(yulopti, yul optimizer exploration tool.
 Usage: yulopti [Options] <file>
 Reads <file> as yul code and applies optimizer steps to it,
-interactively read from stdin.
+interactively read from stdin. With --measure, runs the default
+optimizer sequence and reports the effect of each step instead.
 
 Allowed options)",
 		po::options_description::m_default_line_length,
@@ -213,6 +364,17 @@ Allowed options)",
 			po::value<string>(),
 			"input file"
 		)
+		(
+			"measure",
+			"Instead of the interactive mode, run the default optimiser sequence and report "
+			"the code size and the gas used by the code after each step."
+		)
+		(
+			"calldata",
+			po::value<vector<string>>(),
+			"Hex encoded call data to execute the code with in the measuring mode. "
+			"Can be given multiple times, the gas is summed up over all call data."
+		)
 		("help", "Show this help screen.");
 
 	// All positional options should be interpreted as input files
@@ -233,7 +395,17 @@ Allowed options)",
 	}
 
 	string input;
-	if (arguments.count("input-file"))
+	if (arguments.count("input-file") && arguments.count("measure"))
+	{
+		vector<bytes> callData;
+		if (arguments.count("calldata"))
+			for (string const& data: arguments["calldata"].as<vector<string>>())
+				callData.emplace_back(fromHex(data, WhenError::Throw));
+		else
+			callData.emplace_back();
+		YulOpti{}.runMeasured(readFileAsString(arguments["input-file"].as<string>()), callData);
+	}
+	else if (arguments.count("input-file"))
 		YulOpti{}.runInteractive(readFileAsString(arguments["input-file"].as<string>()));
 	else
 		cout << options;